@@ -0,0 +1,102 @@
+#include "Benchmark.hpp"
+
+#include "MMeter.h"
+#include "Trace.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+std::chrono::duration<double> renderTimedFrame(AssetCollection &collection)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+    {
+        PROFILE_SCOPE("Render iteration");
+
+        collection.render();
+    }
+    auto endTime = std::chrono::high_resolution_clock::now();
+
+    return endTime - startTime;
+}
+
+bool writeToReportPath(const Options &options, const std::function<void(std::ostream &)> &write)
+{
+    if (options.reportPath.empty()) {
+        write(std::cout);
+        return true;
+    }
+
+    std::ofstream file(options.reportPath);
+    if (!file) {
+        std::cerr << "Cannot open " << options.reportPath << " for writing" << std::endl;
+        return false;
+    }
+    write(file);
+    std::cerr << "Report written to " << options.reportPath << std::endl;
+    return true;
+}
+
+bool writeReport(const Report &report, const Options &options)
+{
+    return writeToReportPath(options, [&](std::ostream &out) { report.writeJson(out); });
+}
+
+void measurePipeline(AssetCollection &collection, Status &status, const Options &options)
+{
+    std::cerr << "Warming up for " << options.warmupFrames << " frames..." << std::endl;
+    for (std::size_t i = 0; i < options.warmupFrames; i++) {
+        collection.framePacer.beginFrame();
+        renderTimedFrame(collection);
+        collection.framePacer.wait();
+    }
+
+    // measure only what happens from now on; the warm-up was explicit so don't detect it
+    MMeter::getThreadLocalTreePtr()->reset();
+    status.resetPipeline(false);
+    collection.gpuProfiler.reset();
+    collection.framePacer.reset();
+    collection.inputLatencyTracker.reset();
+    collection.resetComposeTimings();
+
+    // a camera path is measured for exactly one pass
+    std::size_t measuredFrames = collection.cameraPathPlayer
+                                     ? collection.cameraPathPlayer->frameCount()
+                                     : options.measuredFrames;
+
+    std::cerr << "Measuring " << measuredFrames << " frames..." << std::endl;
+    for (std::size_t i = 0; i < measuredFrames; i++) {
+        collection.framePacer.beginFrame();
+        auto frameDuration = renderTimedFrame(collection);
+        status.update(frameDuration);
+        collection.frameFinished(frameDuration);
+        collection.framePacer.wait();
+    }
+    status.collectProfilerData();
+    collection.gpuProfiler.flush();
+    collection.inputLatencyTracker.flush();
+}
+
+int runBenchmark(AssetCollection &collection, Status &status, const Options &options)
+{
+    measurePipeline(collection, status, options);
+
+    Report report{options, status};
+    if (collection.cameraPathPlayer) {
+        report.p_cameraPath = &*collection.cameraPathPlayer;
+    }
+    report.p_memoryBudget = &collection.memoryBudget;
+    report.propCount = collection.propCount();
+    if (collection.frustumCuller) {
+        report.p_frustumCuller = &*collection.frustumCuller;
+    }
+    if (collection.occlusionCuller) {
+        report.p_occlusionCuller = &*collection.occlusionCuller;
+    }
+    report.p_gpuTimes = &collection.gpuProfiler.getTotals();
+    report.p_framePacer = &collection.framePacer;
+    report.p_inputLatencyTracker = &collection.inputLatencyTracker;
+    report.p_comparisonViews = &collection.comparisonViews;
+    report.p_composeHistogram = &collection.composeHistogram;
+    return writeReport(report, options) ? 0 : 1;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <ostream>
+
+#include "Options.hpp"
+#include "Report.hpp"
+#include "Status.hpp"
+#include "assetCollection.hpp"
+
+/**
+ * Calls write with a stream to options.reportPath or stdout if not set
+ * @returns whether it succeeded
+ */
+bool writeToReportPath(const Options &options, const std::function<void(std::ostream &)> &write);
+
+/**
+ * Writes the report to options.reportPath or stdout if not set
+ * @returns whether it succeeded
+ */
+bool writeReport(const Report &report, const Options &options);
+
+// Renders one frame inside the "Render iteration" MMeter scope, @returns its duration
+std::chrono::duration<double> renderTimedFrame(AssetCollection &collection);
+
+/**
+ * Renders the warm-up frames, then the measured frames with fresh pipeline stats and profiler data
+ */
+void measurePipeline(AssetCollection &collection, Status &status, const Options &options);
+
+/**
+ * Renders the headless benchmark (warm-up frames followed by measured frames)
+ * on the calling thread and writes the report.
+ * @returns the process exit code
+ */
+int runBenchmark(AssetCollection &collection, Status &status, const Options &options);
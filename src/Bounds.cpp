@@ -0,0 +1,20 @@
+#include "Bounds.hpp"
+
+#include "glm/gtc/quaternion.hpp"
+
+Bounds propBounds(const Prop &prop)
+{
+    const auto &localBounds = prop.p_model->getBoundingBox();
+    glm::vec3 localCenter = (localBounds.getMin() + localBounds.getMax()) * 0.5f;
+    glm::vec3 localExtent = (localBounds.getMax() - localBounds.getMin()) * 0.5f;
+
+    const auto &transform = prop.transform;
+    glm::mat3 rotation = glm::mat3_cast(transform.rotation);
+    glm::vec3 center = transform.position + rotation * (transform.scaling * localCenter);
+
+    // the extent of the rotated box along each world axis
+    glm::mat3 absRotation(glm::abs(rotation[0]), glm::abs(rotation[1]), glm::abs(rotation[2]));
+    glm::vec3 extent = absRotation * glm::abs(transform.scaling * localExtent);
+
+    return Bounds{.min = center - extent, .max = center + extent};
+}
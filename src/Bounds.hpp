@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Vitrae/Assets/Scene.hpp"
+
+#include "glm/glm.hpp"
+
+#include <limits>
+
+using namespace Vitrae;
+
+/**
+ * Axis-aligned bounding box
+ */
+struct Bounds
+{
+    // empty bounds, which merging anything into replaces
+    glm::vec3 min{std::numeric_limits<float>::max()};
+    glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+    bool isEmpty() const { return min.x > max.x; }
+    glm::vec3 center() const { return (min + max) * 0.5f; }
+    // half of the size
+    glm::vec3 extent() const { return (max - min) * 0.5f; }
+
+    void merge(const Bounds &other)
+    {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+};
+
+// world-space bounds of the prop's model, as placed by its transform
+Bounds propBounds(const Prop &prop);
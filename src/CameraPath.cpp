@@ -0,0 +1,170 @@
+#include "CameraPath.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+// far more than any benchmark renders (over 190 days at 60 fps), and keeps frameCount() in range
+constexpr long long MAX_TOTAL_FRAMES = 1'000'000'000;
+} // namespace
+
+CameraPath CameraPath::load(const std::filesystem::path &filepath)
+{
+    std::ifstream file(filepath);
+    if (!file) {
+        throw std::runtime_error("Cannot open camera path " + filepath.string());
+    }
+
+    CameraPath path;
+    std::string line;
+    std::size_t lineNumber = 0;
+    long long totalFrames = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream ss(line);
+        CameraKeyframe keyframe;
+        // signed, so that negative counts are rejected instead of wrapping around
+        long long frames = 0;
+        ss >> frames >> keyframe.position.x >> keyframe.position.y >>
+            keyframe.position.z >> keyframe.rotation.w >> keyframe.rotation.x >>
+            keyframe.rotation.y >> keyframe.rotation.z;
+        if (!ss || frames < 1) {
+            throw std::runtime_error("Invalid keyframe at " + filepath.string() + ":" +
+                                     std::to_string(lineNumber));
+        }
+        if (frames > MAX_TOTAL_FRAMES - totalFrames) {
+            throw std::runtime_error("Camera path " + filepath.string() + " is longer than " +
+                                     std::to_string(MAX_TOTAL_FRAMES) + " frames at line " +
+                                     std::to_string(lineNumber));
+        }
+        totalFrames += frames;
+        keyframe.frames = (std::size_t)frames;
+        keyframe.rotation = glm::normalize(keyframe.rotation);
+        path.keyframes.push_back(keyframe);
+    }
+
+    if (path.keyframes.empty()) {
+        throw std::runtime_error("Camera path " + filepath.string() + " has no keyframes");
+    }
+
+    return path;
+}
+
+void CameraPath::save(const std::filesystem::path &filepath) const
+{
+    std::ofstream file(filepath);
+    if (!file) {
+        throw std::runtime_error("Cannot write camera path " + filepath.string());
+    }
+
+    file << "# frames px py pz qw qx qy qz" << std::endl;
+    file.precision(9);
+    for (auto &keyframe : keyframes) {
+        file << keyframe.frames << ' ' << keyframe.position.x << ' ' << keyframe.position.y
+             << ' ' << keyframe.position.z << ' ' << keyframe.rotation.w << ' '
+             << keyframe.rotation.x << ' ' << keyframe.rotation.y << ' ' << keyframe.rotation.z
+             << std::endl;
+    }
+}
+
+std::size_t CameraPath::frameCount() const
+{
+    if (keyframes.empty()) {
+        return 0;
+    }
+
+    // the last keyframe is shown once and doesn't lead anywhere
+    std::size_t count = 1;
+    for (std::size_t i = 0; i + 1 < keyframes.size(); i++) {
+        count += keyframes[i].frames;
+    }
+    return count;
+}
+
+CameraPathPlayer::CameraPathPlayer(CameraPath path, bool loop)
+    : m_path(std::move(path)), m_loop(loop), m_frameCount(m_path.frameCount()), m_segment(0),
+      m_frameInSegment(0), m_finished(false),
+      m_segmentStats(std::max<std::size_t>(m_path.keyframes.size(), 1))
+{}
+
+void CameraPathPlayer::advance(std::chrono::duration<double> lastFrameDuration)
+{
+    if (m_finished) {
+        return;
+    }
+
+    SegmentStats &stats = m_segmentStats[m_segment];
+    stats.frameCount++;
+    stats.sumFrameDuration += lastFrameDuration;
+    stats.maxFrameDuration = std::max(stats.maxFrameDuration, lastFrameDuration);
+
+    if (m_segment + 1 >= m_path.keyframes.size()) {
+        // we just showed the last keyframe
+        if (m_loop) {
+            m_segment = 0;
+            m_frameInSegment = 0;
+        } else {
+            m_finished = true;
+        }
+        return;
+    }
+
+    if (++m_frameInSegment >= m_path.keyframes[m_segment].frames) {
+        m_segment++;
+        m_frameInSegment = 0;
+    }
+}
+
+bool CameraPathPlayer::finished() const
+{
+    return m_finished;
+}
+
+void CameraPathPlayer::resetStats()
+{
+    for (auto &stats : m_segmentStats) {
+        stats = SegmentStats{};
+    }
+}
+
+void CameraPathPlayer::rewind()
+{
+    m_segment = 0;
+    m_frameInSegment = 0;
+    m_finished = false;
+    resetStats();
+}
+
+glm::vec3 CameraPathPlayer::currentPosition() const
+{
+    const CameraKeyframe &from = m_path.keyframes[m_segment];
+    if (m_segment + 1 >= m_path.keyframes.size()) {
+        return from.position;
+    }
+    return glm::mix(from.position, m_path.keyframes[m_segment + 1].position, currentFactor());
+}
+
+glm::quat CameraPathPlayer::currentRotation() const
+{
+    const CameraKeyframe &from = m_path.keyframes[m_segment];
+    if (m_segment + 1 >= m_path.keyframes.size()) {
+        return from.rotation;
+    }
+    return glm::slerp(from.rotation, m_path.keyframes[m_segment + 1].rotation, currentFactor());
+}
+
+float CameraPathPlayer::currentFactor() const
+{
+    return (float)m_frameInSegment / (float)m_path.keyframes[m_segment].frames;
+}
+
+CameraPathRecorder::CameraPathRecorder(std::size_t interval)
+    : m_interval(std::max<std::size_t>(interval, 1)), m_recordedFrameCount(0)
+{}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+struct CameraKeyframe
+{
+    glm::vec3 position;
+    glm::quat rotation;
+    // number of rendered frames it takes to reach the next keyframe
+    std::size_t frames;
+};
+
+/**
+ * A sequence of camera keyframes, stored as a text file with one keyframe per line:
+ * frames px py pz qw qx qy qz
+ */
+struct CameraPath
+{
+    std::vector<CameraKeyframe> keyframes;
+
+    static CameraPath load(const std::filesystem::path &filepath);
+    void save(const std::filesystem::path &filepath) const;
+
+    // total number of frames needed to play the whole path
+    std::size_t frameCount() const;
+};
+
+/**
+ * Plays back a camera path frame-locked: every rendered frame advances the path by exactly one
+ * interpolation step regardless of wall-clock time, so each run renders the same views.
+ * Frame durations are attributed to the segment (pair of keyframes) they were rendered in
+ */
+class CameraPathPlayer
+{
+  public:
+    struct SegmentStats
+    {
+        std::size_t frameCount = 0;
+        std::chrono::duration<double> sumFrameDuration{0.0};
+        std::chrono::duration<double> maxFrameDuration{0.0};
+    };
+
+    CameraPathPlayer(CameraPath path, bool loop);
+
+    // sets the pose of the current frame
+    template <class CameraT> void apply(CameraT &camera) const
+    {
+        camera.position = currentPosition();
+        camera.rotation = currentRotation();
+    }
+    // moves to the next frame, attributing the duration of the just rendered frame
+    void advance(std::chrono::duration<double> lastFrameDuration);
+
+    bool finished() const;
+    std::size_t frameCount() const { return m_frameCount; }
+    const std::vector<SegmentStats> &getSegmentStats() const { return m_segmentStats; }
+    void resetStats();
+    // back to the first frame, with fresh stats
+    void rewind();
+
+  private:
+    CameraPath m_path;
+    bool m_loop;
+    std::size_t m_frameCount;
+
+    std::size_t m_segment;
+    std::size_t m_frameInSegment;
+    bool m_finished;
+
+    std::vector<SegmentStats> m_segmentStats;
+
+    glm::vec3 currentPosition() const;
+    glm::quat currentRotation() const;
+    float currentFactor() const;
+};
+
+/**
+ * Samples the camera pose every N rendered frames
+ */
+class CameraPathRecorder
+{
+  public:
+    CameraPathRecorder(std::size_t interval);
+
+    template <class CameraT> void record(const CameraT &camera)
+    {
+        if (m_recordedFrameCount++ % m_interval == 0) {
+            m_path.keyframes.push_back(CameraKeyframe{
+                .position = camera.position,
+                .rotation = camera.rotation,
+                .frames = m_interval,
+            });
+        }
+    }
+
+    const CameraPath &getPath() const { return m_path; }
+
+  private:
+    CameraPath m_path;
+    std::size_t m_interval;
+    std::size_t m_recordedFrameCount;
+};
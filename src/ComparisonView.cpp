@@ -0,0 +1,30 @@
+#include "ComparisonView.hpp"
+
+ComparisonView::ComparisonView(ComponentRoot &root, std::mutex &engineMutex,
+                               const std::map<std::string, std::string> &overrides)
+    : overrides(overrides), p_builder(std::make_unique<PipelineBuilder>(root, engineMutex))
+{
+    for (auto &[key, option] : overrides) {
+        if (!name.empty()) {
+            name += ",";
+        }
+        name += key + "=" + option;
+    }
+}
+
+PipelineConfig ComparisonView::applyTo(const PipelineConfig &mainConfig) const
+{
+    PipelineConfig config = mainConfig;
+    for (auto &[key, option] : overrides) {
+        if (key == OUTPUT_KEY) {
+            config.desiredOutputs = ParamList();
+            config.desiredOutputs.insert_back(ParamSpec{
+                .name = option,
+                .typeInfo = TYPE_INFO<void>,
+            });
+        } else {
+            config.aliases[key] = option;
+        }
+    }
+    return config;
+}
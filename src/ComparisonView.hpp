@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Vitrae/Assets/Compositor.hpp"
+#include "Vitrae/Assets/FrameStore.hpp"
+#include "Vitrae/Assets/Texture.hpp"
+
+#include "FrameTimeHistogram.hpp"
+#include "PipelineBuilder.hpp"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+using namespace Vitrae;
+
+/**
+ * A pipeline configuration rendered next to the main one, from the same scene, for comparing
+ * the two in the same frame. It differs from the main configuration by some method options
+ * (or the output), and has its own compositor, parameters and frame,
+ * while the scene and its GPU resources are shared
+ */
+struct ComparisonView
+{
+    // override key that replaces the desired output
+    static inline const std::string OUTPUT_KEY = "output";
+
+    // the overrides, as "name=option,..."
+    std::string name;
+    // method property (or OUTPUT_KEY) -> option
+    std::map<std::string, std::string> overrides;
+
+    // rebuilds the view whenever the main pipeline changes
+    std::unique_ptr<PipelineBuilder> p_builder;
+    // null until the first build finishes
+    std::unique_ptr<Compositor> p_comp;
+    // what p_comp was built for
+    PipelineConfig config;
+    std::chrono::duration<double> buildDuration{0.0};
+    // whether p_comp goes to the pipeline cache when replaced, like the main pipeline
+    bool cacheable = false;
+
+    dynasma::FirmPtr<FrameStore> p_frame;
+    dynasma::FirmPtr<Texture> p_colorTexture;
+
+    // CPU time of each compose, since the last pipeline change
+    FrameTimeHistogram composeHistogram;
+
+    ComparisonView(ComponentRoot &root, std::mutex &engineMutex,
+                   const std::map<std::string, std::string> &overrides);
+
+    // the main configuration with the overrides applied
+    PipelineConfig applyTo(const PipelineConfig &mainConfig) const;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// Quotes a CSV field if it contains separators, quotes or line breaks
+inline std::string csvField(std::string_view str)
+{
+    if (str.find_first_of(",\"\n") == std::string_view::npos) {
+        return std::string(str);
+    }
+    std::string quoted = "\"";
+    for (char c : str) {
+        if (c == '"') {
+            quoted += '"';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
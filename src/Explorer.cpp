@@ -0,0 +1,304 @@
+#include "Explorer.hpp"
+
+#include "Benchmark.hpp"
+#include "Csv.hpp"
+#include "FrameReadback.hpp"
+#include "Image.hpp"
+#include "JsonWriter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+
+namespace
+{
+constexpr std::size_t DEFAULT_STEPS = 5;
+
+enum class InputType
+{
+    Float,
+    Double,
+    Int32,
+    UInt32,
+    Size,
+    // both components get the explored value
+    UVec2,
+};
+
+struct ExploredInput
+{
+    std::string name;
+    InputType type;
+    std::vector<double> values;
+};
+
+std::optional<InputType> inputTypeOf(const ParamSpec &spec)
+{
+    if (spec.typeInfo == TYPE_INFO<float>) {
+        return InputType::Float;
+    } else if (spec.typeInfo == TYPE_INFO<double>) {
+        return InputType::Double;
+    } else if (spec.typeInfo == TYPE_INFO<std::int32_t>) {
+        return InputType::Int32;
+    } else if (spec.typeInfo == TYPE_INFO<std::uint32_t>) {
+        return InputType::UInt32;
+    } else if (spec.typeInfo == TYPE_INFO<std::size_t>) {
+        return InputType::Size;
+    } else if (spec.typeInfo == TYPE_INFO<glm::uvec2>) {
+        return InputType::UVec2;
+    }
+    return std::nullopt;
+}
+
+bool isPowerOfTwo(double value)
+{
+    return value >= 1.0 && std::exp2(std::round(std::log2(value))) == value;
+}
+
+std::vector<double> rangeValues(const ExploreRange &range, bool integral)
+{
+    std::vector<double> values;
+
+    if (integral && range.steps == 0 && isPowerOfTwo(range.from) && isPowerOfTwo(range.to)) {
+        double factor = range.to >= range.from ? 2.0 : 0.5;
+        for (double value = range.from; value != range.to; value *= factor) {
+            values.push_back(value);
+        }
+        values.push_back(range.to);
+        return values;
+    }
+
+    std::size_t steps = range.steps ? range.steps : DEFAULT_STEPS;
+    for (std::size_t i = 0; i < steps; i++) {
+        double value = range.from + (range.to - range.from) * (double)i / (double)(steps - 1);
+        if (integral) {
+            value = std::round(value);
+        }
+        if (values.empty() || values.back() != value) {
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+
+std::vector<ExploredInput> exploredInputs(const Compositor &comp, const Options &options)
+{
+    std::vector<ExploredInput> inputs;
+    for (auto &range : options.exploreRanges) {
+        auto &specs = comp.getInputSpecs().getSpecList();
+        auto it = std::find_if(specs.begin(), specs.end(),
+                               [&](const ParamSpec &spec) { return spec.name == range.name; });
+        if (it == specs.end()) {
+            throw std::invalid_argument("The pipeline has no input " + range.name);
+        }
+        std::optional<InputType> type = inputTypeOf(*it);
+        if (!type) {
+            throw std::invalid_argument("Input " + range.name + " isn't numeric");
+        }
+
+        bool integral = *type != InputType::Float && *type != InputType::Double;
+        inputs.push_back(ExploredInput{range.name, *type, rangeValues(range, integral)});
+    }
+    return inputs;
+}
+
+void applyValues(AssetCollection &collection, const std::vector<ExploredInput> &inputs,
+                 const std::vector<double> &values)
+{
+    for (std::size_t i = 0; i < inputs.size(); i++) {
+        const String &name = inputs[i].name;
+        double value = values[i];
+        switch (inputs[i].type) {
+        case InputType::Float:
+            collection.setSharedParameter(name, (float)value);
+            break;
+        case InputType::Double:
+            collection.setSharedParameter(name, value);
+            break;
+        case InputType::Int32:
+            collection.setSharedParameter(name, (std::int32_t)value);
+            break;
+        case InputType::UInt32:
+            collection.setSharedParameter(name, (std::uint32_t)value);
+            break;
+        case InputType::Size:
+            collection.setSharedParameter(name, (std::size_t)value);
+            break;
+        case InputType::UVec2:
+            collection.setSharedParameter(name,
+                                          glm::uvec2((std::uint32_t)value, (std::uint32_t)value));
+            break;
+        }
+    }
+
+    // sizes can be baked into the pipeline, so build it with the new values
+    collection.pipelineCache.clear();
+    collection.shouldReloadPipelines = true;
+    collection.waitForPipeline();
+}
+
+// renders the first view of the camera path (or the initial view) and reads it back
+Image captureFrame(AssetCollection &collection)
+{
+    if (collection.cameraPathPlayer) {
+        collection.cameraPathPlayer->rewind();
+    }
+    collection.render();
+    return readTexture(*collection.p_displayColorTexture);
+}
+} // namespace
+
+void ExploreTable::markParetoFront()
+{
+    for (auto &point : points) {
+        point.paretoOptimal = std::none_of(points.begin(), points.end(), [&](const Point &other) {
+            return other.meanFrameDuration <= point.meanFrameDuration && other.ssim >= point.ssim &&
+                   (other.meanFrameDuration < point.meanFrameDuration || other.ssim > point.ssim);
+        });
+    }
+}
+
+void ExploreTable::writeJson(std::ostream &out) const
+{
+    JsonWriter json(out);
+
+    json.beginObject();
+    json.key("reference");
+    json.beginObject();
+    for (auto &[name, value] : reference) {
+        json.field(name, value);
+    }
+    json.endObject();
+
+    json.key("points");
+    json.beginArray();
+    for (auto &point : points) {
+        json.beginObject();
+        json.key("values");
+        json.beginObject();
+        for (auto &[name, value] : point.values) {
+            json.field(name, value);
+        }
+        json.endObject();
+        json.field("meanMs", point.meanFrameDuration.count() * 1000.0);
+        json.field("p99Ms", point.percentiles.p99.count() * 1000.0);
+        // infinite for the reference itself, written as null
+        json.field("psnr", point.psnr);
+        json.field("ssim", point.ssim);
+        json.field("pareto", point.paretoOptimal);
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    out << std::endl;
+}
+
+void ExploreTable::writeCsv(std::ostream &out) const
+{
+    for (auto &input : inputs) {
+        out << csvField(input) << ",";
+    }
+    out << "mean_ms,p99_ms,psnr,ssim,pareto" << std::endl;
+
+    for (auto &point : points) {
+        for (auto &input : inputs) {
+            out << point.values.at(input) << ",";
+        }
+        out << point.meanFrameDuration.count() * 1000.0 << ","
+            << point.percentiles.p99.count() * 1000.0 << "," << point.psnr << "," << point.ssim
+            << "," << (point.paretoOptimal ? "true" : "false") << std::endl;
+    }
+}
+
+int runExplorer(AssetCollection &collection, Status &status, const Options &options)
+{
+    std::vector<ExploredInput> inputs;
+    try {
+        inputs = exploredInputs(*collection.p_comp, options);
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    ExploreTable table;
+    std::vector<double> referenceValues;
+    std::size_t pointCount = 1;
+    for (auto &input : inputs) {
+        table.inputs.push_back(input.name);
+        table.reference[input.name] = input.values.back();
+        referenceValues.push_back(input.values.back());
+        pointCount *= input.values.size();
+    }
+
+    std::cerr << "Rendering the reference frame..." << std::endl;
+    applyValues(collection, inputs, referenceValues);
+    for (std::size_t i = 0; i < options.warmupFrames; i++) {
+        collection.render();
+    }
+    Image reference = captureFrame(collection);
+
+    std::vector<double> values(inputs.size());
+    for (std::size_t pointIndex = 0; pointIndex < pointCount; pointIndex++) {
+        ExploreTable::Point &point = table.points.emplace_back();
+
+        // the last input changes fastest
+        std::size_t remainingIndex = pointIndex;
+        for (std::size_t i = inputs.size(); i-- > 0;) {
+            values[i] = inputs[i].values[remainingIndex % inputs[i].values.size()];
+            remainingIndex /= inputs[i].values.size();
+            point.values[inputs[i].name] = values[i];
+        }
+
+        std::cerr << "Point " << pointIndex + 1 << "/" << pointCount << ":";
+        for (auto &[name, value] : point.values) {
+            std::cerr << " " << name << "=" << value;
+        }
+        std::cerr << std::endl;
+
+        applyValues(collection, inputs, values);
+        if (collection.cameraPathPlayer) {
+            collection.cameraPathPlayer->rewind();
+        }
+        measurePipeline(collection, status, options);
+        point.meanFrameDuration = status.pipelineHistogram.mean();
+        point.percentiles = FrameTimePercentiles(status.pipelineHistogram);
+
+        Image image = captureFrame(collection);
+        point.psnr = psnr(image, reference);
+        point.ssim = ssim(image, reference);
+    }
+
+    table.markParetoFront();
+
+    std::cerr << "Pareto front:" << std::endl;
+    std::vector<const ExploreTable::Point *> front;
+    for (auto &point : table.points) {
+        if (point.paretoOptimal) {
+            front.push_back(&point);
+        }
+    }
+    std::sort(front.begin(), front.end(), [](const auto *p_a, const auto *p_b) {
+        return p_a->meanFrameDuration < p_b->meanFrameDuration;
+    });
+    for (auto *p_point : front) {
+        std::cerr << "  " << p_point->meanFrameDuration.count() * 1000.0 << "ms, SSIM "
+                  << p_point->ssim << ":";
+        for (auto &[name, value] : p_point->values) {
+            std::cerr << " " << name << "=" << value;
+        }
+        std::cerr << std::endl;
+    }
+
+    bool asCsv = options.reportPath.extension() == ".csv";
+    bool written = writeToReportPath(options, [&](std::ostream &out) {
+        if (asCsv) {
+            table.writeCsv(out);
+        } else {
+            table.writeJson(out);
+        }
+    });
+    return written ? 0 : 1;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "FrameTimeHistogram.hpp"
+#include "Options.hpp"
+#include "Status.hpp"
+#include "assetCollection.hpp"
+
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Frame times and image quality of compositor input combinations
+ */
+struct ExploreTable
+{
+    struct Point
+    {
+        // input name -> value
+        std::map<std::string, double> values;
+        std::chrono::duration<double> meanFrameDuration{0.0};
+        FrameTimePercentiles percentiles;
+        // compared to the reference frame
+        double psnr = 0.0;
+        double ssim = 0.0;
+        // no other point is both faster and closer to the reference
+        bool paretoOptimal = false;
+    };
+
+    std::vector<std::string> inputs;
+    std::map<std::string, double> reference;
+    std::vector<Point> points;
+
+    void markParetoFront();
+
+    void writeJson(std::ostream &out) const;
+    void writeCsv(std::ostream &out) const;
+};
+
+/**
+ * Renders a fixed view with every combination of the options.exploreRanges values,
+ * measuring the frame time and SSIM/PSNR against the reference values' frame,
+ * and writes the points with their Pareto front.
+ * @returns the process exit code
+ */
+int runExplorer(AssetCollection &collection, Status &status, const Options &options);
@@ -0,0 +1,66 @@
+#include "glad/glad.h"
+
+#include "FrameBlitter.hpp"
+
+#include "VitraePluginOpenGL/Assets/Texture.hpp"
+
+FrameBlitter::FrameBlitter() : m_readFramebuffer(0), m_drawFramebuffer(0), m_created(false) {}
+
+void FrameBlitter::blitToWindow(const Texture &source, glm::uvec2 offset, glm::uvec2 size)
+{
+    blit(source, nullptr, offset, size);
+}
+
+void FrameBlitter::blitToTexture(const Texture &source, const Texture &target)
+{
+    blit(source, &target, glm::uvec2(0), target.getSize());
+}
+
+void FrameBlitter::clearWindow(glm::vec4 color)
+{
+    GLint previousDraw;
+    GLfloat previousColor[4];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousDraw);
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, previousColor);
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glClearColor(color.r, color.g, color.b, color.a);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    glClearColor(previousColor[0], previousColor[1], previousColor[2], previousColor[3]);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, previousDraw);
+}
+
+void FrameBlitter::blit(const Texture &source, const Texture *p_target, glm::uvec2 targetOffset,
+                        glm::uvec2 targetSize)
+{
+    if (!m_created) {
+        glGenFramebuffers(1, &m_readFramebuffer);
+        glGenFramebuffers(1, &m_drawFramebuffer);
+        m_created = true;
+    }
+
+    // the renderer expects its own bindings to stay in place
+    GLint previousRead, previousDraw;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousRead);
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousDraw);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_readFramebuffer);
+    glFramebufferTexture2D(GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           dynamic_cast<const OpenGLTexture &>(source).glTextureId, 0);
+    if (p_target) {
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_drawFramebuffer);
+        glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                               dynamic_cast<const OpenGLTexture &>(*p_target).glTextureId, 0);
+    } else {
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    }
+
+    glm::uvec2 sourceSize = source.getSize();
+    glm::uvec2 targetEnd = targetOffset + targetSize;
+    glBlitFramebuffer(0, 0, sourceSize.x, sourceSize.y, targetOffset.x, targetOffset.y,
+                      targetEnd.x, targetEnd.y, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, previousRead);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, previousDraw);
+}
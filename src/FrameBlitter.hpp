@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Vitrae/Assets/Texture.hpp"
+
+#include "glm/glm.hpp"
+
+using namespace Vitrae;
+
+/**
+ * Copies the textures of the OpenGL renderer into the window or other textures,
+ * scaled to fit with linear filtering. Must be used on the render thread
+ */
+class FrameBlitter
+{
+  public:
+    FrameBlitter();
+
+    // into a viewport of the window
+    void blitToWindow(const Texture &source, glm::uvec2 offset, glm::uvec2 size);
+    void blitToTexture(const Texture &source, const Texture &target);
+    void clearWindow(glm::vec4 color);
+
+  private:
+    // created on first use, when the context is surely current
+    unsigned int m_readFramebuffer;
+    unsigned int m_drawFramebuffer;
+    bool m_created;
+
+    // blits into the window if there's no target texture
+    void blit(const Texture &source, const Texture *p_target, glm::uvec2 targetOffset,
+              glm::uvec2 targetSize);
+};
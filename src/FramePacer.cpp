@@ -0,0 +1,155 @@
+#include "FramePacer.hpp"
+
+#include "Trace.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+double FramePacer::Stats::idleFraction() const
+{
+    auto loopDuration = busyDuration + idleDuration;
+    return loopDuration.count() > 0.0 ? idleDuration / loopDuration : 0.0;
+}
+
+FramePacer::FramePacer(Mode mode, double targetRate)
+    : m_mode(mode), m_targetRate(targetRate), m_hasDeadline(false), m_hasFrameStart(false),
+      m_percentilesTimeStamp(Clock::now()), m_vsyncChecked(false),
+      m_intervalSquaredDeviation(0.0)
+{}
+
+void FramePacer::setMode(Mode mode, double targetRate)
+{
+    m_mode = mode;
+    m_targetRate = targetRate;
+    m_hasDeadline = false;
+    m_vsyncChecked = false;
+    reset();
+}
+
+FramePacer::Mode FramePacer::getMode() const
+{
+    return m_mode;
+}
+
+double FramePacer::getTargetRate() const
+{
+    return m_targetRate;
+}
+
+void FramePacer::beginFrame()
+{
+    Clock::time_point now = Clock::now();
+
+    if (m_hasFrameStart) {
+        std::chrono::duration<double> interval = now - m_frameStart;
+        m_intervalHistogram.add(interval);
+
+        // Welford's update, which stays accurate over long runs
+        double count = (double)m_intervalHistogram.count();
+        double deviation = interval.count() - m_stats.avgInterval.count();
+        m_stats.avgInterval += std::chrono::duration<double>(deviation / count);
+        m_intervalSquaredDeviation += deviation * (interval.count() - m_stats.avgInterval.count());
+        m_stats.intervalJitter = std::chrono::duration<double>(
+            std::sqrt(m_intervalSquaredDeviation / count));
+    }
+    if (now - m_percentilesTimeStamp >= 1s) {
+        m_stats.intervalPercentiles = FrameTimePercentiles(m_intervalHistogram);
+        m_percentilesTimeStamp = now;
+
+        if (m_mode == Mode::VSync && !m_vsyncChecked && m_intervalHistogram.count() > 0) {
+            m_vsyncChecked = true;
+            if (m_stats.avgInterval.count() < 1.0 / MAX_DISPLAY_RATE) {
+                std::cerr << "VSync is on, but frames start every "
+                          << m_stats.avgInterval.count() * 1000.0
+                          << " ms; the present doesn't wait for the display" << std::endl;
+            }
+        }
+    }
+
+    if (!m_hasDeadline) {
+        m_deadline = now;
+        m_hasDeadline = true;
+    }
+    m_frameStart = now;
+    m_hasFrameStart = true;
+    m_stats.frameCount++;
+}
+
+void FramePacer::wait()
+{
+    Clock::time_point waitStart = Clock::now();
+    // a frame that was reset in the middle isn't measured
+    bool measured = m_hasFrameStart;
+
+    {
+        TraceScope traceScope("Frame pacing");
+
+        switch (m_mode) {
+        case Mode::Uncapped:
+            break;
+        case Mode::FixedRate:
+            m_deadline += std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(1.0 / m_targetRate));
+            // a late frame doesn't make the following ones hurry to catch up
+            if (m_deadline < waitStart) {
+                m_deadline = waitStart;
+            }
+            waitUntil(m_deadline);
+            break;
+        case Mode::VSync:
+            // the present already waited
+            break;
+        }
+    }
+
+    if (measured) {
+        m_stats.busyDuration += waitStart - m_frameStart;
+        m_stats.idleDuration += Clock::now() - waitStart;
+    }
+}
+
+void FramePacer::reset()
+{
+    m_stats = Stats();
+    m_intervalHistogram.reset();
+    m_intervalSquaredDeviation = 0.0;
+    // the interval to the next frame would span the reset
+    m_hasFrameStart = false;
+    m_percentilesTimeStamp = Clock::now();
+}
+
+FramePacer::Stats FramePacer::getStats() const
+{
+    return m_stats;
+}
+
+const FrameTimeHistogram &FramePacer::getIntervalHistogram() const
+{
+    return m_intervalHistogram;
+}
+
+const char *FramePacer::modeName(Mode mode)
+{
+    switch (mode) {
+    case Mode::FixedRate:
+        return "fixed rate";
+    case Mode::VSync:
+        return "vsync";
+    default:
+        return "uncapped";
+    }
+}
+
+void FramePacer::waitUntil(Clock::time_point deadline)
+{
+    Clock::time_point now = Clock::now();
+    if (deadline - now > SPIN_THRESHOLD) {
+        std::this_thread::sleep_for(deadline - now - SPIN_THRESHOLD);
+    }
+    while (Clock::now() < deadline) {
+        // spinning keeps the wake-up within microseconds of the deadline
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "FrameTimeHistogram.hpp"
+
+#include <chrono>
+#include <cstddef>
+
+/**
+ * Paces the render loop: as fast as possible, to a fixed frame rate, or to the display refresh.
+ * Also measures the intervals between frame starts and how the loop's time splits into
+ * working on frames and waiting for the next one
+ */
+class FramePacer
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Mode
+    {
+        Uncapped,
+        // sleeps, then spins until the next frame is due
+        FixedRate,
+        // the present blocks until the display refresh
+        VSync
+    };
+
+    // of the fixed rate mode, if none was given
+    static constexpr double DEFAULT_TARGET_RATE = 60.0;
+    // remaining waits shorter than this are spun, since sleeps overshoot by up to a timer slice
+    static constexpr std::chrono::microseconds SPIN_THRESHOLD{1500};
+    // in vsync mode, a faster average rate than any display's means the present didn't wait
+    static constexpr double MAX_DISPLAY_RATE = 500.0;
+
+    struct Stats
+    {
+        std::size_t frameCount = 0;
+        std::chrono::duration<double> avgInterval{0.0};
+        // standard deviation of the intervals
+        std::chrono::duration<double> intervalJitter{0.0};
+        // updated once per second
+        FrameTimePercentiles intervalPercentiles;
+        // from the frame starts to the waits; with vsync, this includes the blocking present
+        std::chrono::duration<double> busyDuration{0.0};
+        std::chrono::duration<double> idleDuration{0.0};
+
+        double idleFraction() const;
+    };
+
+    // the target rate (in Hz) is used in the fixed rate mode only
+    FramePacer(Mode mode, double targetRate);
+
+    void setMode(Mode mode, double targetRate);
+    Mode getMode() const;
+    double getTargetRate() const;
+
+    // to be called right before each frame's work
+    void beginFrame();
+    // waits until the next frame is due; to be called after each frame, outside of any locks
+    void wait();
+
+    // restarts the stats, but keeps pacing from the latest frame
+    void reset();
+    Stats getStats() const;
+    const FrameTimeHistogram &getIntervalHistogram() const;
+
+    static const char *modeName(Mode mode);
+
+  private:
+    Mode m_mode;
+    double m_targetRate;
+    // when the next fixed rate frame is due; reset to the next frame start if not pacing yet
+    Clock::time_point m_deadline;
+    bool m_hasDeadline;
+
+    Clock::time_point m_frameStart;
+    bool m_hasFrameStart;
+    Clock::time_point m_percentilesTimeStamp;
+    // the vsync check warns once per mode change
+    bool m_vsyncChecked;
+
+    Stats m_stats;
+    FrameTimeHistogram m_intervalHistogram;
+    // running variance of the intervals (Welford), in seconds squared times the count
+    double m_intervalSquaredDeviation;
+
+    static void waitUntil(Clock::time_point deadline);
+};
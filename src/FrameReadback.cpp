@@ -0,0 +1,24 @@
+#include "glad/glad.h"
+
+#include "FrameReadback.hpp"
+
+#include "VitraePluginOpenGL/Assets/Texture.hpp"
+
+Image readTexture(const Texture &texture)
+{
+    const auto &glTexture = dynamic_cast<const OpenGLTexture &>(texture);
+    glm::uvec2 size = texture.getSize();
+
+    Image image{
+        .width = size.x,
+        .height = size.y,
+        .pixels = std::vector<std::uint8_t>((std::size_t)size.x * size.y * 3),
+    };
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glBindTexture(GL_TEXTURE_2D, glTexture.glTextureId);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, image.pixels.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return image;
+}
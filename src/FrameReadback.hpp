@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Image.hpp"
+
+#include "Vitrae/Assets/Texture.hpp"
+
+using namespace Vitrae;
+
+/**
+ * Copies an RGB texture of the OpenGL renderer to the CPU.
+ * Must be called on the render thread, after the frame using the texture was composed
+ */
+Image readTexture(const Texture &texture);
@@ -0,0 +1,89 @@
+#include "FrameTimeHistogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+FrameTimeHistogram::FrameTimeHistogram()
+{
+    reset();
+}
+
+void FrameTimeHistogram::add(Duration duration)
+{
+    double ns = std::max(duration.count() * 1e9, 0.0);
+    m_buckets[bucketIndex((std::uint64_t)ns)]++;
+
+    if (m_count == 0 || duration < m_min) {
+        m_min = duration;
+    }
+    if (duration > m_max) {
+        m_max = duration;
+    }
+    m_sum += duration;
+    m_count++;
+}
+
+void FrameTimeHistogram::reset()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_sum = Duration(0.0);
+    m_min = Duration(0.0);
+    m_max = Duration(0.0);
+}
+
+FrameTimeHistogram::Duration FrameTimeHistogram::percentile(double fraction) const
+{
+    if (m_count == 0) {
+        return Duration(0.0);
+    }
+
+    // the sample with this 1-based rank is the one we're looking for
+    std::size_t rank = std::max<std::size_t>(1, (std::size_t)std::ceil(fraction * m_count));
+
+    std::size_t seen = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; i++) {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            // report the middle of the bucket, clamped to the exactly known range
+            double lower = (double)bucketLowerBound(i);
+            double upper =
+                (i + 1 < BUCKET_COUNT) ? (double)bucketLowerBound(i + 1) : lower * 2.0;
+            Duration mid((lower + upper) * 0.5e-9);
+            return std::clamp(mid, m_min, m_max);
+        }
+    }
+    return m_max;
+}
+
+std::size_t FrameTimeHistogram::bucketIndex(std::uint64_t nanoseconds)
+{
+    if (nanoseconds < SUB_BUCKET_COUNT) {
+        return nanoseconds;
+    }
+
+    std::size_t exponent = std::bit_width(nanoseconds) - 1;
+    if (exponent >= MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+    std::size_t subBucket =
+        (nanoseconds >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + subBucket;
+}
+
+std::uint64_t FrameTimeHistogram::bucketLowerBound(std::size_t index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    std::size_t exponent = index / SUB_BUCKET_COUNT - 1 + SUB_BUCKET_BITS;
+    std::uint64_t subBucket = index % SUB_BUCKET_COUNT;
+    return ((std::uint64_t)1 << exponent) | (subBucket << (exponent - SUB_BUCKET_BITS));
+}
+
+FrameTimePercentiles::FrameTimePercentiles(const FrameTimeHistogram &histogram)
+    : p50(histogram.percentile(0.5)), p90(histogram.percentile(0.9)),
+      p99(histogram.percentile(0.99)), p999(histogram.percentile(0.999)), max(histogram.max())
+{}
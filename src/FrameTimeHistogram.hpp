@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Fixed-size histogram of frame durations with logarithmic buckets.
+ * Each power of two (in nanoseconds) is split into SUB_BUCKET_COUNT linear sub-buckets,
+ * which keeps the relative error of percentiles below ~3%.
+ * Adding a sample takes constant time and never allocates, so it's safe for the render thread
+ */
+class FrameTimeHistogram
+{
+  public:
+    using Duration = std::chrono::duration<double>;
+
+    static constexpr std::size_t SUB_BUCKET_BITS = 5;
+    static constexpr std::size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    // largest tracked duration is 2^MAX_EXPONENT ns (~18 minutes), longer ones are clamped
+    static constexpr std::size_t MAX_EXPONENT = 40;
+    static constexpr std::size_t BUCKET_COUNT =
+        (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    FrameTimeHistogram();
+
+    void add(Duration duration);
+    void reset();
+
+    std::size_t count() const { return m_count; }
+    Duration min() const { return m_count ? m_min : Duration(0.0); }
+    Duration max() const { return m_max; }
+    Duration mean() const { return m_count ? m_sum / (double)m_count : Duration(0.0); }
+
+    // @param fraction in [0, 1], e.g. 0.99 for the 99th percentile
+    Duration percentile(double fraction) const;
+
+  private:
+    std::array<std::uint32_t, BUCKET_COUNT> m_buckets;
+    std::size_t m_count;
+    Duration m_sum;
+    Duration m_min;
+    Duration m_max;
+
+    static std::size_t bucketIndex(std::uint64_t nanoseconds);
+    static std::uint64_t bucketLowerBound(std::size_t index);
+};
+
+/**
+ * The percentiles we display and export
+ */
+struct FrameTimePercentiles
+{
+    FrameTimeHistogram::Duration p50{0.0};
+    FrameTimeHistogram::Duration p90{0.0};
+    FrameTimeHistogram::Duration p99{0.0};
+    FrameTimeHistogram::Duration p999{0.0};
+    FrameTimeHistogram::Duration max{0.0};
+
+    FrameTimePercentiles() = default;
+    FrameTimePercentiles(const FrameTimeHistogram &histogram);
+};
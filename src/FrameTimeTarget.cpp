@@ -0,0 +1,48 @@
+#include "FrameTimeTarget.hpp"
+
+#include <utility>
+
+FrameTimeTarget::FrameTimeTarget(std::chrono::duration<double> target)
+    : m_target(target), m_settling(true)
+{}
+
+void FrameTimeTarget::setTarget(std::chrono::duration<double> target)
+{
+    m_target = target;
+    m_settling = true;
+}
+
+std::chrono::duration<double> FrameTimeTarget::getTarget() const
+{
+    return m_target;
+}
+
+bool FrameTimeTarget::isEnabled() const
+{
+    return m_target.count() > 0.0;
+}
+
+std::optional<double> FrameTimeTarget::update(const Status &status)
+{
+    // wait for a new average
+    if (!isEnabled() || status.currentTimeStamp == m_lastAverageTime) {
+        return std::nullopt;
+    }
+    m_lastAverageTime = status.currentTimeStamp;
+
+    // the frames after a pipeline change or an adjustment aren't representative
+    if (status.pipelineWarmingUp || std::exchange(m_settling, false)) {
+        return std::nullopt;
+    }
+
+    double ratio = status.currentAvgFrameDuration / m_target;
+    if (ratio > 1.0 + TOLERANCE || ratio < 1.0 - TOLERANCE) {
+        return ratio;
+    }
+    return std::nullopt;
+}
+
+void FrameTimeTarget::settle()
+{
+    m_settling = true;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Status.hpp"
+
+#include <chrono>
+#include <optional>
+
+/**
+ * Tells frame time controllers when to react to the average frame duration.
+ * Each new one-second average of the Status is compared to the target; deviations within
+ * a tolerance, warm-up frames and the first average after an adjustment are ignored,
+ * so the controllers settle instead of oscillating
+ */
+class FrameTimeTarget
+{
+  public:
+    // relative deviation from the target that isn't corrected
+    static constexpr double TOLERANCE = 0.1;
+
+    // a zero target disables the control
+    FrameTimeTarget(std::chrono::duration<double> target);
+
+    void setTarget(std::chrono::duration<double> target);
+    std::chrono::duration<double> getTarget() const;
+    bool isEnabled() const;
+
+    // @returns the ratio of the new average to the target, if it needs correcting
+    std::optional<double> update(const Status &status);
+    // to be called after each adjustment, since the next average includes older frames
+    void settle();
+
+  private:
+    std::chrono::duration<double> m_target;
+    std::chrono::steady_clock::time_point m_lastAverageTime;
+    bool m_settling;
+};
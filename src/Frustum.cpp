@@ -0,0 +1,87 @@
+#include "Frustum.hpp"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FRUSTUM_USE_SSE
+#endif
+
+Frustum::Frustum(const glm::mat4 &viewProjection)
+{
+    auto row = [&](int i) {
+        return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i],
+                         viewProjection[3][i]);
+    };
+    std::array<glm::vec4, 6> planes = {
+        row(3) + row(0), row(3) - row(0), // left, right
+        row(3) + row(1), row(3) - row(1), // bottom, top
+        row(3) + row(2), row(3) - row(2), // near, far
+    };
+
+    for (std::size_t i = 0; i < PLANE_COUNT; i++) {
+        glm::vec4 plane = i < planes.size() ? planes[i] / glm::length(glm::vec3(planes[i]))
+                                            : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        m_normalX[i] = plane.x;
+        m_normalY[i] = plane.y;
+        m_normalZ[i] = plane.z;
+        m_distance[i] = plane.w;
+    }
+}
+
+Frustum::Visibility Frustum::test(const Bounds &bounds) const
+{
+    glm::vec3 center = bounds.center();
+    glm::vec3 extent = bounds.extent();
+
+    // the signed distance of the center from each plane, compared to
+    // the box's projected radius onto the plane normal
+    int outsideMask = 0;
+    int intersectingMask = 0;
+#ifdef FRUSTUM_USE_SSE
+    __m128 centerX = _mm_set1_ps(center.x);
+    __m128 centerY = _mm_set1_ps(center.y);
+    __m128 centerZ = _mm_set1_ps(center.z);
+    __m128 extentX = _mm_set1_ps(extent.x);
+    __m128 extentY = _mm_set1_ps(extent.y);
+    __m128 extentZ = _mm_set1_ps(extent.z);
+    __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 zero = _mm_setzero_ps();
+
+    for (std::size_t i = 0; i < PLANE_COUNT; i += 4) {
+        __m128 normalX = _mm_load_ps(&m_normalX[i]);
+        __m128 normalY = _mm_load_ps(&m_normalY[i]);
+        __m128 normalZ = _mm_load_ps(&m_normalZ[i]);
+
+        __m128 distance = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(normalX, centerX), _mm_mul_ps(normalY, centerY)),
+            _mm_add_ps(_mm_mul_ps(normalZ, centerZ), _mm_load_ps(&m_distance[i])));
+        __m128 radius = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm_and_ps(normalX, absMask), extentX),
+                       _mm_mul_ps(_mm_and_ps(normalY, absMask), extentY)),
+            _mm_mul_ps(_mm_and_ps(normalZ, absMask), extentZ));
+
+        outsideMask |= _mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(distance, radius), zero));
+        intersectingMask |= _mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(distance, radius), zero));
+    }
+#else
+    for (std::size_t i = 0; i < PLANE_COUNT; i++) {
+        float distance = m_normalX[i] * center.x + m_normalY[i] * center.y +
+                         m_normalZ[i] * center.z + m_distance[i];
+        float radius = std::abs(m_normalX[i]) * extent.x + std::abs(m_normalY[i]) * extent.y +
+                       std::abs(m_normalZ[i]) * extent.z;
+        outsideMask |= distance + radius < 0.0f;
+        intersectingMask |= distance - radius < 0.0f;
+    }
+#endif
+
+    if (outsideMask) {
+        return Visibility::Outside;
+    }
+    return intersectingMask ? Visibility::Intersecting : Visibility::Inside;
+}
+
+glm::mat4 cameraViewProjection(const Camera &camera, glm::vec2 frameSize)
+{
+    return camera.getPerspectiveMatrix(frameSize.x, frameSize.y) * camera.getViewMatrix();
+}
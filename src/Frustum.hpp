@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Bounds.hpp"
+
+#include "Vitrae/Assets/Scene.hpp"
+
+#include "glm/glm.hpp"
+
+#include <array>
+
+using namespace Vitrae;
+
+/**
+ * View frustum as six planes, tested against bounds four planes at a time
+ */
+class Frustum
+{
+  public:
+    enum class Visibility
+    {
+        Outside,
+        Intersecting,
+        Inside
+    };
+
+    // extracts the planes from a view-projection matrix with OpenGL clip space
+    Frustum(const glm::mat4 &viewProjection);
+
+    Visibility test(const Bounds &bounds) const;
+
+  private:
+    // the 6 planes are padded with planes that everything is in front of
+    static constexpr std::size_t PLANE_COUNT = 8;
+
+    // planes in structure-of-arrays layout, for testing them together
+    alignas(16) std::array<float, PLANE_COUNT> m_normalX;
+    alignas(16) std::array<float, PLANE_COUNT> m_normalY;
+    alignas(16) std::array<float, PLANE_COUNT> m_normalZ;
+    alignas(16) std::array<float, PLANE_COUNT> m_distance;
+};
+
+glm::mat4 cameraViewProjection(const Camera &camera, glm::vec2 frameSize);
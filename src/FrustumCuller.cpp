@@ -0,0 +1,120 @@
+#include "FrustumCuller.hpp"
+
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+FrustumCuller::FrustumCuller(Scene &scene) : m_props(std::move(scene.modelProps))
+{
+    scene.modelProps.clear();
+
+    m_propBounds.reserve(m_props.size());
+    for (auto &prop : m_props) {
+        m_propBounds.push_back(propBounds(prop));
+    }
+
+    m_order.resize(m_props.size());
+    std::iota(m_order.begin(), m_order.end(), 0);
+    if (!m_props.empty()) {
+        m_nodes.reserve(2 * m_props.size() / MAX_LEAF_SIZE + 1);
+        build(0, (std::uint32_t)m_props.size());
+    }
+
+    m_stats.propCount = m_props.size();
+}
+
+std::size_t FrustumCuller::propCount() const
+{
+    return m_props.size();
+}
+
+void FrustumCuller::cull(Scene &scene, const Frustum &frustum)
+{
+    PROFILE_SCOPE("Frustum culling");
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    m_visible.clear();
+    m_stats.testCount = 0;
+    if (!m_nodes.empty()) {
+        m_stack.push_back(0);
+    }
+    while (!m_stack.empty()) {
+        const Node &node = m_nodes[m_stack.back()];
+        m_stack.pop_back();
+
+        m_stats.testCount++;
+        Frustum::Visibility visibility = frustum.test(node.bounds);
+        if (visibility == Frustum::Visibility::Inside) {
+            // no need to test what's inside
+            addRange(node);
+        } else if (visibility == Frustum::Visibility::Intersecting) {
+            if (node.isLeaf()) {
+                for (std::uint32_t i = node.first; i < node.first + node.count; i++) {
+                    m_stats.testCount++;
+                    if (frustum.test(m_propBounds[m_order[i]]) != Frustum::Visibility::Outside) {
+                        m_visible.push_back(m_order[i]);
+                    }
+                }
+            } else {
+                m_stack.push_back(node.right);
+                m_stack.push_back(node.left);
+            }
+        }
+    }
+
+    // the scene keeps its capacity, but each copy still references the model
+    scene.modelProps.clear();
+    for (std::uint32_t index : m_visible) {
+        scene.modelProps.push_back(m_props[index]);
+    }
+
+    m_stats.visibleCount = m_visible.size();
+    m_stats.cullDuration = std::chrono::steady_clock::now() - startTime;
+}
+
+FrustumCuller::Stats FrustumCuller::getStats() const
+{
+    return m_stats;
+}
+
+std::uint32_t FrustumCuller::build(std::uint32_t first, std::uint32_t count)
+{
+    std::uint32_t index = (std::uint32_t)m_nodes.size();
+    m_nodes.push_back(Node{.first = first, .count = count});
+
+    Bounds bounds;
+    Bounds centerBounds;
+    for (std::uint32_t i = first; i < first + count; i++) {
+        const Bounds &itemBounds = m_propBounds[m_order[i]];
+        bounds.merge(itemBounds);
+        centerBounds.merge(Bounds{itemBounds.center(), itemBounds.center()});
+    }
+    m_nodes[index].bounds = bounds;
+
+    if (count <= MAX_LEAF_SIZE) {
+        return index;
+    }
+
+    // split at the median along the axis where the prop centers are spread the most
+    glm::vec3 spread = centerBounds.max - centerBounds.min;
+    int axis = spread.x > spread.y ? (spread.x > spread.z ? 0 : 2) : (spread.y > spread.z ? 1 : 2);
+    std::uint32_t middle = first + count / 2;
+    std::nth_element(m_order.begin() + first, m_order.begin() + middle,
+                     m_order.begin() + first + count, [&](std::uint32_t a, std::uint32_t b) {
+                         return m_propBounds[a].center()[axis] < m_propBounds[b].center()[axis];
+                     });
+
+    std::uint32_t left = build(first, middle - first);
+    std::uint32_t right = build(middle, first + count - middle);
+    m_nodes[index].left = left;
+    m_nodes[index].right = right;
+    return index;
+}
+
+void FrustumCuller::addRange(const Node &node)
+{
+    m_visible.insert(m_visible.end(), m_order.begin() + node.first,
+                     m_order.begin() + node.first + node.count);
+}
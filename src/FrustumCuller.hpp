@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Bounds.hpp"
+#include "Frustum.hpp"
+
+#include "Vitrae/Assets/Scene.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace Vitrae;
+
+/**
+ * Keeps only the props inside the view frustum in the scene, so the compositor doesn't submit
+ * the rest. The culler owns all props in a bounding volume hierarchy and copies the visible
+ * ones into the scene before each frame.
+ * The hierarchy is static: props can't be moved once the culler has taken them over
+ */
+class FrustumCuller
+{
+  public:
+    struct Stats
+    {
+        std::size_t propCount = 0;
+        std::size_t visibleCount = 0;
+        // hierarchy nodes and props tested against the frustum
+        std::size_t testCount = 0;
+        // includes copying the visible props, with their model references, into the scene
+        std::chrono::duration<double> cullDuration{0.0};
+    };
+
+    // takes over the props of the scene
+    FrustumCuller(Scene &scene);
+
+    std::size_t propCount() const;
+
+    // replaces the props of the scene with the ones inside the frustum
+    void cull(Scene &scene, const Frustum &frustum);
+
+    Stats getStats() const;
+
+  private:
+    static constexpr std::size_t MAX_LEAF_SIZE = 4;
+    static constexpr std::uint32_t NO_NODE = ~std::uint32_t(0);
+
+    // nodes are stored in depth-first order, so children come after their parent
+    // and every node covers a contiguous range of m_order
+    struct Node
+    {
+        Bounds bounds;
+        std::uint32_t first;
+        std::uint32_t count;
+        std::uint32_t left = NO_NODE;
+        std::uint32_t right = NO_NODE;
+
+        bool isLeaf() const { return left == NO_NODE; }
+    };
+
+    std::vector<Prop> m_props;
+    std::vector<Bounds> m_propBounds;
+    // prop indices, ordered by the hierarchy
+    std::vector<std::uint32_t> m_order;
+    std::vector<Node> m_nodes;
+
+    std::vector<std::uint32_t> m_visible;
+    std::vector<std::uint32_t> m_stack;
+    Stats m_stats;
+
+    std::uint32_t build(std::uint32_t first, std::uint32_t count);
+    void addRange(const Node &node);
+};
@@ -0,0 +1,109 @@
+#include "glad/glad.h"
+
+#include "GpuProfiler.hpp"
+
+GpuProfiler::Scope::Scope(GpuProfiler &profiler, const char *name) : m_profiler(profiler)
+{
+    FrameQueries &frame = profiler.m_frames[profiler.m_currentFrame];
+    m_index = frame.scopes.size();
+    frame.scopes.push_back(PendingScope{.name = name, .startQuery = profiler.takeQuery()});
+    glQueryCounter(frame.scopes[m_index].startQuery, GL_TIMESTAMP);
+}
+
+GpuProfiler::Scope::~Scope()
+{
+    FrameQueries &frame = m_profiler.m_frames[m_profiler.m_currentFrame];
+    frame.scopes[m_index].endQuery = m_profiler.takeQuery();
+    glQueryCounter(frame.scopes[m_index].endQuery, GL_TIMESTAMP);
+}
+
+GpuProfiler::GpuProfiler()
+    : m_currentFrame(0), mp_publishedTotals(std::make_shared<const GpuTimes>())
+{}
+
+void GpuProfiler::beginFrame()
+{
+    // from the oldest frame; a frame's results can't arrive before the previous frame's
+    for (std::size_t i = 1; i < FRAME_LATENCY; i++) {
+        if (!collect(m_frames[(m_currentFrame + i) % FRAME_LATENCY], false)) {
+            break;
+        }
+    }
+
+    m_currentFrame = (m_currentFrame + 1) % FRAME_LATENCY;
+    // all frames in flight: wait for the oldest one rather than lose it
+    collect(m_frames[m_currentFrame], true);
+}
+
+void GpuProfiler::reset()
+{
+    m_totals.clear();
+    mp_publishedTotals = std::make_shared<const GpuTimes>();
+    for (auto &frame : m_frames) {
+        frame.stale = !frame.scopes.empty();
+    }
+}
+
+void GpuProfiler::flush()
+{
+    for (std::size_t i = 1; i <= FRAME_LATENCY; i++) {
+        collect(m_frames[(m_currentFrame + i) % FRAME_LATENCY], true);
+    }
+}
+
+const GpuTimes &GpuProfiler::getTotals() const
+{
+    return m_totals;
+}
+
+std::shared_ptr<const GpuTimes> GpuProfiler::getTimes()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - m_publishTime >= PUBLISH_INTERVAL && *mp_publishedTotals != m_totals) {
+        mp_publishedTotals = std::make_shared<const GpuTimes>(m_totals);
+        m_publishTime = now;
+    }
+    return mp_publishedTotals;
+}
+
+unsigned int GpuProfiler::takeQuery()
+{
+    FrameQueries &frame = m_frames[m_currentFrame];
+    if (frame.usedQueryCount == frame.queryPool.size()) {
+        GLuint query;
+        glGenQueries(1, &query);
+        frame.queryPool.push_back(query);
+    }
+    return frame.queryPool[frame.usedQueryCount++];
+}
+
+bool GpuProfiler::collect(FrameQueries &frame, bool wait)
+{
+    if (frame.scopes.empty()) {
+        return true;
+    }
+
+    // the last issued query is the last to complete
+    if (!wait) {
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(frame.queryPool[frame.usedQueryCount - 1], GL_QUERY_RESULT_AVAILABLE,
+                            &available);
+        if (!available) {
+            return false;
+        }
+    }
+
+    for (auto &scope : frame.scopes) {
+        GLuint64 startTime, endTime;
+        glGetQueryObjectui64v(scope.startQuery, GL_QUERY_RESULT, &startTime);
+        glGetQueryObjectui64v(scope.endQuery, GL_QUERY_RESULT, &endTime);
+        if (!frame.stale) {
+            m_totals[scope.name] += std::chrono::nanoseconds(endTime - startTime);
+        }
+    }
+
+    frame.scopes.clear();
+    frame.usedQueryCount = 0;
+    frame.stale = false;
+    return true;
+}
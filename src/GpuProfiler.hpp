@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// GPU time spent in each named scope
+using GpuTimes = std::map<std::string, std::chrono::duration<double>>;
+
+/**
+ * Measures the GPU time of named scopes with OpenGL timestamp queries.
+ * The results are read a few frames later, once the GPU has them, so measuring doesn't stall.
+ * Must be used on the render thread
+ */
+class GpuProfiler
+{
+  public:
+    // frames whose queries can be in flight
+    static constexpr std::size_t FRAME_LATENCY = 4;
+    // how often getTimes() returns new totals, as often as the CPU profiler aggregates
+    static constexpr std::chrono::seconds PUBLISH_INTERVAL{1};
+
+    /**
+     * Measures the GPU work issued during its lifetime.
+     * Scope names match the MMeter scopes around the same work, for showing them together
+     */
+    class Scope
+    {
+      public:
+        Scope(GpuProfiler &profiler, const char *name);
+        ~Scope();
+
+      private:
+        GpuProfiler &m_profiler;
+        std::size_t m_index;
+    };
+
+    GpuProfiler();
+
+    // to be called at the start of each frame
+    void beginFrame();
+    // forgets the measured totals
+    void reset();
+    // waits for the results of all frames in flight
+    void flush();
+
+    // totals since the last reset, of the frames whose results arrived
+    const GpuTimes &getTotals() const;
+    // a copy of the totals for other threads, renewed once per publish interval
+    std::shared_ptr<const GpuTimes> getTimes();
+
+  private:
+    struct PendingScope
+    {
+        const char *name;
+        unsigned int startQuery;
+        unsigned int endQuery;
+    };
+
+    struct FrameQueries
+    {
+        std::vector<PendingScope> scopes;
+        // queries created so far, reused in later frames
+        std::vector<unsigned int> queryPool;
+        std::size_t usedQueryCount = 0;
+        // whether the frame's results were measured before the last reset
+        bool stale = false;
+    };
+
+    std::array<FrameQueries, FRAME_LATENCY> m_frames;
+    std::size_t m_currentFrame;
+    GpuTimes m_totals;
+    std::shared_ptr<const GpuTimes> mp_publishedTotals;
+    std::chrono::steady_clock::time_point m_publishTime;
+
+    unsigned int takeQuery();
+    // @returns whether the results were available, they're waited for if wait is set
+    bool collect(FrameQueries &frame, bool wait);
+};
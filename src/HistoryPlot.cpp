@@ -0,0 +1,74 @@
+#include "HistoryPlot.h"
+
+#include <QtGui/QPainter>
+#include <QtGui/QPainterPath>
+
+#include <algorithm>
+
+HistoryPlot::HistoryPlot(QWidget *parent, std::size_t capacity)
+    : QWidget(parent), m_capacity(capacity), m_limit(0.0)
+{
+    setMinimumHeight(60);
+}
+
+HistoryPlot::~HistoryPlot() {}
+
+void HistoryPlot::addValue(double value)
+{
+    m_values.push_back(value);
+    while (m_values.size() > m_capacity) {
+        m_values.pop_front();
+    }
+    update();
+}
+
+void HistoryPlot::setLimit(double limit)
+{
+    if (m_limit != limit) {
+        m_limit = limit;
+        update();
+    }
+}
+
+QSize HistoryPlot::sizeHint() const
+{
+    return QSize(200, 80);
+}
+
+void HistoryPlot::paintEvent(QPaintEvent *event)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+
+    if (m_values.empty()) {
+        return;
+    }
+
+    double maxValue = std::max(*std::max_element(m_values.begin(), m_values.end()), m_limit);
+    if (maxValue <= 0.0) {
+        return;
+    }
+    double xStep = (double)width() / std::max<std::size_t>(m_capacity - 1, 1);
+    auto yFor = [&](double value) { return height() - 1 - value / maxValue * (height() - 2); };
+
+    if (m_limit > 0.0) {
+        painter.setPen(QPen(Qt::red, 1, Qt::DashLine));
+        painter.drawLine(QPointF(0, yFor(m_limit)), QPointF(width(), yFor(m_limit)));
+    }
+
+    // newest value on the right edge
+    QPainterPath path;
+    double x = width() - xStep * (m_values.size() - 1);
+    path.moveTo(x, yFor(m_values.front()));
+    for (auto it = m_values.begin() + 1; it != m_values.end(); ++it) {
+        x += xStep;
+        path.lineTo(x, yFor(*it));
+    }
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(QPen(palette().text().color(), 1.5));
+    painter.drawPath(path);
+
+    painter.setPen(palette().text().color());
+    painter.drawText(rect().adjusted(4, 2, -4, -2), Qt::AlignTop | Qt::AlignLeft,
+                     QString::number(m_values.back(), 'f', 1));
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QtWidgets/QWidget>
+
+#include <deque>
+
+/**
+ * Line plot of the latest values of a measurement, with an optional limit line
+ */
+class HistoryPlot : public QWidget
+{
+  public:
+    HistoryPlot(QWidget *parent = nullptr, std::size_t capacity = 120);
+    virtual ~HistoryPlot();
+
+    void addValue(double value);
+    // 0 hides the limit line
+    void setLimit(double limit);
+
+    QSize sizeHint() const override;
+
+  protected:
+    void paintEvent(QPaintEvent *event) override;
+
+  private:
+    std::size_t m_capacity;
+    std::deque<double> m_values;
+    double m_limit;
+};
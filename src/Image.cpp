@@ -0,0 +1,80 @@
+#include "Image.hpp"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace
+{
+constexpr std::size_t SSIM_WINDOW_SIZE = 8;
+
+void checkComparable(const Image &image, const Image &reference)
+{
+    if (image.width != reference.width || image.height != reference.height ||
+        image.pixels.size() != reference.pixels.size()) {
+        throw std::invalid_argument("Cannot compare images of different sizes");
+    }
+}
+
+double luminance(const Image &image, std::size_t x, std::size_t y)
+{
+    const std::uint8_t *p_pixel = &image.pixels[(y * image.width + x) * 3];
+    return 0.299 * p_pixel[0] + 0.587 * p_pixel[1] + 0.114 * p_pixel[2];
+}
+} // namespace
+
+double psnr(const Image &image, const Image &reference)
+{
+    checkComparable(image, reference);
+
+    double sumSquaredError = 0.0;
+    for (std::size_t i = 0; i < image.pixels.size(); i++) {
+        double error = (double)image.pixels[i] - (double)reference.pixels[i];
+        sumSquaredError += error * error;
+    }
+    if (sumSquaredError == 0.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double meanSquaredError = sumSquaredError / (double)image.pixels.size();
+    return 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+}
+
+double ssim(const Image &image, const Image &reference)
+{
+    checkComparable(image, reference);
+
+    // stabilizing constants from the original SSIM paper, for 8-bit values
+    constexpr double C1 = (0.01 * 255.0) * (0.01 * 255.0);
+    constexpr double C2 = (0.03 * 255.0) * (0.03 * 255.0);
+    constexpr double N = SSIM_WINDOW_SIZE * SSIM_WINDOW_SIZE;
+
+    double sumSsim = 0.0;
+    std::size_t windowCount = 0;
+    for (std::size_t wy = 0; wy + SSIM_WINDOW_SIZE <= image.height; wy += SSIM_WINDOW_SIZE) {
+        for (std::size_t wx = 0; wx + SSIM_WINDOW_SIZE <= image.width; wx += SSIM_WINDOW_SIZE) {
+            double sumA = 0.0, sumB = 0.0, sumAA = 0.0, sumBB = 0.0, sumAB = 0.0;
+            for (std::size_t y = wy; y < wy + SSIM_WINDOW_SIZE; y++) {
+                for (std::size_t x = wx; x < wx + SSIM_WINDOW_SIZE; x++) {
+                    double a = luminance(image, x, y);
+                    double b = luminance(reference, x, y);
+                    sumA += a;
+                    sumB += b;
+                    sumAA += a * a;
+                    sumBB += b * b;
+                    sumAB += a * b;
+                }
+            }
+
+            double meanA = sumA / N, meanB = sumB / N;
+            double varianceA = sumAA / N - meanA * meanA;
+            double varianceB = sumBB / N - meanB * meanB;
+            double covariance = sumAB / N - meanA * meanB;
+
+            sumSsim += ((2.0 * meanA * meanB + C1) * (2.0 * covariance + C2)) /
+                       ((meanA * meanA + meanB * meanB + C1) * (varianceA + varianceB + C2));
+            windowCount++;
+        }
+    }
+
+    return windowCount ? sumSsim / (double)windowCount : 1.0;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 8-bit RGB image read back from a frame
+ */
+struct Image
+{
+    std::size_t width = 0;
+    std::size_t height = 0;
+    // 3 bytes per pixel, rows without padding
+    std::vector<std::uint8_t> pixels;
+};
+
+// Peak signal-to-noise ratio in dB over all channels, infinity for identical images
+double psnr(const Image &image, const Image &reference);
+
+// Mean structural similarity of the luminance over 8x8 windows, 1 for identical images
+double ssim(const Image &image, const Image &reference);
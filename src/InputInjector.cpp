@@ -0,0 +1,49 @@
+#include "InputInjector.hpp"
+
+#include "Trace.hpp"
+
+InputInjector::InputInjector(AssetCollection &collection, double rate)
+    : m_collection(collection), m_interval(1.0 / rate), m_stopRequested(false),
+      m_injectedCount(0)
+{
+    m_thread = std::thread([this]() { threadLoop(); });
+}
+
+InputInjector::~InputInjector()
+{
+    {
+        std::unique_lock lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_stopCondition.notify_one();
+    m_thread.join();
+}
+
+std::size_t InputInjector::getInjectedCount() const
+{
+    std::unique_lock lock(m_mutex);
+    return m_injectedCount;
+}
+
+void InputInjector::threadLoop()
+{
+    TraceRecorder::instance().setThreadName("Input injector");
+
+    auto nextTime = std::chrono::steady_clock::now();
+    std::unique_lock lock(m_mutex);
+    while (true) {
+        nextTime += std::chrono::duration_cast<std::chrono::steady_clock::duration>(m_interval);
+        if (m_stopCondition.wait_until(lock, nextTime, [this]() { return m_stopRequested; })) {
+            break;
+        }
+
+        float direction = m_injectedCount % 2 == 0 ? 1.0f : -1.0f;
+        m_injectedCount++;
+        lock.unlock();
+
+        TraceRecorder::instance().record("Injected input", TraceRecorder::EventType::Instant);
+        m_collection.queueDrag(glm::vec2(direction * DRAG_DISTANCE, 0.0f), false, true, false);
+
+        lock.lock();
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "assetCollection.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+/**
+ * Feeds synthetic camera drags to the asset collection at a fixed rate, from its own thread,
+ * in place of the window's input events when running headless.
+ * Must be the only thread that queues commands
+ */
+class InputInjector
+{
+  public:
+    // horizontal drag of each event, in pixels; alternating in direction, so the view stays put
+    static constexpr float DRAG_DISTANCE = 4.0f;
+
+    // @param rate in events per second
+    InputInjector(AssetCollection &collection, double rate);
+    ~InputInjector();
+
+    std::size_t getInjectedCount() const;
+
+  private:
+    AssetCollection &m_collection;
+    std::chrono::duration<double> m_interval;
+    std::thread m_thread;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_stopCondition;
+    bool m_stopRequested;
+    std::size_t m_injectedCount;
+
+    void threadLoop();
+};
@@ -0,0 +1,155 @@
+#include "glad/glad.h"
+
+#include "InputLatencyTracker.hpp"
+
+#include <algorithm>
+#include <utility>
+
+using namespace std::chrono_literals;
+
+InputLatencyTracker::InputLatencyTracker()
+    : m_frameNumber(0), m_queries{}, m_nextQuery(0), m_created(false), m_sumFrameDelay(0),
+      m_percentilesTimeStamp(Clock::now())
+{}
+
+InputLatencyTracker::Stamp InputLatencyTracker::stamp() const
+{
+    return Stamp{
+        .time = Clock::now(),
+        .frameNumber = m_frameNumber.load(std::memory_order_relaxed),
+    };
+}
+
+void InputLatencyTracker::beginFrame()
+{
+    m_frameNumber.fetch_add(1, std::memory_order_relaxed);
+
+    // from the oldest frame; a frame can't finish before the previous one
+    for (std::size_t i = 0; i < QUERY_COUNT; i++) {
+        if (!collect((m_nextQuery + i) % QUERY_COUNT, false)) {
+            break;
+        }
+    }
+
+    Clock::time_point now = Clock::now();
+    if (now - m_percentilesTimeStamp >= 1s) {
+        m_stats.toCompose = FrameTimePercentiles(m_composeHistogram);
+        m_stats.toPresent = FrameTimePercentiles(m_presentHistogram);
+        m_percentilesTimeStamp = now;
+    }
+}
+
+void InputLatencyTracker::inputApplied(const Stamp &stamp)
+{
+    std::size_t frameDelay = m_frameNumber.load(std::memory_order_relaxed) - stamp.frameNumber;
+    m_stats.inputCount++;
+    m_sumFrameDelay += frameDelay;
+    m_stats.avgFrameDelay = (double)m_sumFrameDelay / m_stats.inputCount;
+    m_stats.maxFrameDelay = std::max(m_stats.maxFrameDelay, frameDelay);
+
+    m_frameInputTimes.push_back(stamp.time);
+}
+
+void InputLatencyTracker::endFrame()
+{
+    // frames without input aren't queried
+    if (m_frameInputTimes.empty()) {
+        return;
+    }
+
+    Clock::time_point now = Clock::now();
+    for (Clock::time_point inputTime : m_frameInputTimes) {
+        m_composeHistogram.add(now - inputTime);
+    }
+
+    if (!m_created) {
+        glGenQueries(QUERY_COUNT, m_queries.data());
+        m_created = true;
+    }
+    // all queries in flight: wait for the oldest one rather than lose it
+    collect(m_nextQuery, true);
+
+    PendingFrame &frame = m_frames[m_nextQuery];
+    std::swap(frame.inputTimes, m_frameInputTimes);
+    m_frameInputTimes.clear();
+
+    GLint64 gpuTime;
+    glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+    frame.issueTime = Clock::now();
+    frame.issueGpuTime = gpuTime;
+    glQueryCounter(m_queries[m_nextQuery], GL_TIMESTAMP);
+    frame.pending = true;
+
+    m_nextQuery = (m_nextQuery + 1) % QUERY_COUNT;
+}
+
+void InputLatencyTracker::reset()
+{
+    m_stats = Stats();
+    m_sumFrameDelay = 0;
+    m_composeHistogram.reset();
+    m_presentHistogram.reset();
+    m_frameInputTimes.clear();
+    // the queries still complete, but without inputs they aren't measured
+    for (auto &frame : m_frames) {
+        frame.inputTimes.clear();
+    }
+    m_percentilesTimeStamp = Clock::now();
+}
+
+void InputLatencyTracker::flush()
+{
+    for (std::size_t i = 0; i < QUERY_COUNT; i++) {
+        collect((m_nextQuery + i) % QUERY_COUNT, true);
+    }
+    m_stats.toCompose = FrameTimePercentiles(m_composeHistogram);
+    m_stats.toPresent = FrameTimePercentiles(m_presentHistogram);
+}
+
+InputLatencyTracker::Stats InputLatencyTracker::getStats() const
+{
+    return m_stats;
+}
+
+const FrameTimeHistogram &InputLatencyTracker::getComposeHistogram() const
+{
+    return m_composeHistogram;
+}
+
+const FrameTimeHistogram &InputLatencyTracker::getPresentHistogram() const
+{
+    return m_presentHistogram;
+}
+
+bool InputLatencyTracker::collect(std::size_t query, bool wait)
+{
+    PendingFrame &frame = m_frames[query];
+    if (!frame.pending) {
+        return true;
+    }
+
+    if (!wait) {
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(m_queries[query], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            return false;
+        }
+    }
+
+    GLuint64 finishGpuTime;
+    glGetQueryObjectui64v(m_queries[query], GL_QUERY_RESULT, &finishGpuTime);
+    // the GPU clock only differs from the CPU clock by an offset
+    std::int64_t finishDelay =
+        std::max<std::int64_t>((std::int64_t)finishGpuTime - frame.issueGpuTime, 0);
+    Clock::time_point finishTime =
+        frame.issueTime +
+        std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(finishDelay));
+    for (Clock::time_point inputTime : frame.inputTimes) {
+        m_presentHistogram.add(finishTime - inputTime);
+    }
+    m_stats.presentedCount += frame.inputTimes.size();
+
+    frame.inputTimes.clear();
+    frame.pending = false;
+    return true;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "FrameTimeHistogram.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Measures how long input events take to become visible: from their arrival to the end of
+ * the compose of the first frame that applies them, and to when the GPU finished that frame.
+ * The GPU finish is read from timestamp queries a few frames later, so measuring doesn't stall.
+ * stamp() can be called on any thread, everything else on the render thread only
+ */
+class InputLatencyTracker
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    // when an input event arrived, and during which frame
+    struct Stamp
+    {
+        Clock::time_point time;
+        std::size_t frameNumber;
+    };
+
+    struct Stats
+    {
+        std::size_t inputCount = 0;
+        // of the inputs whose frames the GPU finished
+        std::size_t presentedCount = 0;
+        // frames started after the arrival of an input, up to the one that applied it
+        double avgFrameDelay = 0.0;
+        std::size_t maxFrameDelay = 0;
+        // updated once per second
+        FrameTimePercentiles toCompose;
+        FrameTimePercentiles toPresent;
+    };
+
+    InputLatencyTracker();
+
+    Stamp stamp() const;
+
+    // to be called at the start of each frame, before the inputs are applied
+    void beginFrame();
+    void inputApplied(const Stamp &stamp);
+    // to be called after the frame was composed and presented
+    void endFrame();
+
+    // forgets the measurements, including those of the frames in flight
+    void reset();
+    // waits for the results of all frames in flight
+    void flush();
+
+    Stats getStats() const;
+    const FrameTimeHistogram &getComposeHistogram() const;
+    const FrameTimeHistogram &getPresentHistogram() const;
+
+  private:
+    // frames with inputs in flight before a result is waited for
+    static constexpr std::size_t QUERY_COUNT = 4;
+
+    struct PendingFrame
+    {
+        std::vector<Clock::time_point> inputTimes;
+        // both clocks when the query was issued, for converting the GPU time to the CPU clock
+        Clock::time_point issueTime;
+        std::int64_t issueGpuTime = 0;
+        bool pending = false;
+    };
+
+    std::atomic<std::size_t> m_frameNumber;
+    // arrival times of the inputs applied in the current frame
+    std::vector<Clock::time_point> m_frameInputTimes;
+
+    // the queries are created on first use, when the context is surely current
+    std::array<unsigned int, QUERY_COUNT> m_queries;
+    std::array<PendingFrame, QUERY_COUNT> m_frames;
+    std::size_t m_nextQuery;
+    bool m_created;
+
+    Stats m_stats;
+    std::size_t m_sumFrameDelay;
+    FrameTimeHistogram m_composeHistogram;
+    FrameTimeHistogram m_presentHistogram;
+    Clock::time_point m_percentilesTimeStamp;
+
+    // @returns whether the result was available, it's waited for if wait is set
+    bool collect(std::size_t query, bool wait);
+};
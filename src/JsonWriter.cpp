@@ -0,0 +1,127 @@
+#include "JsonWriter.hpp"
+
+#include <cmath>
+#include <iomanip>
+#include <limits>
+
+JsonWriter::JsonWriter(std::ostream &out) : m_out(out), m_afterKey(false) {}
+
+void JsonWriter::beginObject()
+{
+    beforeValue();
+    m_out << '{';
+    m_scopeHasItems.push_back(false);
+}
+
+void JsonWriter::endObject()
+{
+    m_scopeHasItems.pop_back();
+    m_out << '}';
+}
+
+void JsonWriter::beginArray()
+{
+    beforeValue();
+    m_out << '[';
+    m_scopeHasItems.push_back(false);
+}
+
+void JsonWriter::endArray()
+{
+    m_scopeHasItems.pop_back();
+    m_out << ']';
+}
+
+void JsonWriter::key(std::string_view name)
+{
+    beforeValue();
+    writeEscaped(name);
+    m_out << ':';
+    m_afterKey = true;
+}
+
+void JsonWriter::value(std::string_view str)
+{
+    beforeValue();
+    writeEscaped(str);
+}
+
+void JsonWriter::value(double num)
+{
+    beforeValue();
+    if (std::isfinite(num)) {
+        m_out << std::setprecision(std::numeric_limits<double>::max_digits10) << num;
+    } else {
+        m_out << "null";
+    }
+}
+
+void JsonWriter::value(std::uint64_t num)
+{
+    beforeValue();
+    m_out << num;
+}
+
+void JsonWriter::value(std::int64_t num)
+{
+    beforeValue();
+    m_out << num;
+}
+
+void JsonWriter::value(bool b)
+{
+    beforeValue();
+    m_out << (b ? "true" : "false");
+}
+
+void JsonWriter::null()
+{
+    beforeValue();
+    m_out << "null";
+}
+
+void JsonWriter::beforeValue()
+{
+    if (m_afterKey) {
+        m_afterKey = false;
+        return;
+    }
+    if (!m_scopeHasItems.empty()) {
+        if (m_scopeHasItems.back()) {
+            m_out << ',';
+        }
+        m_scopeHasItems.back() = true;
+    }
+}
+
+void JsonWriter::writeEscaped(std::string_view str)
+{
+    m_out << '"';
+    for (char c : str) {
+        switch (c) {
+        case '"':
+            m_out << "\\\"";
+            break;
+        case '\\':
+            m_out << "\\\\";
+            break;
+        case '\n':
+            m_out << "\\n";
+            break;
+        case '\r':
+            m_out << "\\r";
+            break;
+        case '\t':
+            m_out << "\\t";
+            break;
+        default:
+            if ((unsigned char)c < 0x20) {
+                static const char hex[] = "0123456789abcdef";
+                m_out << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+            } else {
+                m_out << c;
+            }
+        }
+    }
+    m_out << '"';
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+/**
+ * Minimal streaming JSON writer used for machine-readable reports.
+ * Commas and string escaping are handled automatically;
+ * the caller is responsible for balancing begin/end calls
+ */
+class JsonWriter
+{
+  public:
+    JsonWriter(std::ostream &out);
+    ~JsonWriter() = default;
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    void key(std::string_view name);
+
+    void value(std::string_view str);
+    void value(const char *str) { value(std::string_view(str)); }
+    void value(double num);
+    void value(std::uint64_t num);
+    void value(std::int64_t num);
+    void value(std::uint32_t num) { value((std::uint64_t)num); }
+    void value(std::int32_t num) { value((std::int64_t)num); }
+    void value(bool b);
+    void null();
+
+    template <class T> void field(std::string_view name, const T &val)
+    {
+        key(name);
+        value(val);
+    }
+
+  private:
+    std::ostream &m_out;
+    std::vector<bool> m_scopeHasItems;
+    bool m_afterKey;
+
+    void beforeValue();
+    void writeEscaped(std::string_view str);
+};
@@ -0,0 +1,53 @@
+#include "LoDController.hpp"
+
+#include <algorithm>
+
+LoDController::LoDController(std::chrono::duration<double> targetFrameDuration)
+    : m_target(targetFrameDuration), m_threshold(DEFAULT_THRESHOLD)
+{}
+
+void LoDController::setTarget(std::chrono::duration<double> targetFrameDuration)
+{
+    m_target.setTarget(targetFrameDuration);
+}
+
+std::chrono::duration<double> LoDController::getTarget() const
+{
+    return m_target.getTarget();
+}
+
+bool LoDController::update(const Status &status)
+{
+    if (!m_target.isEnabled()) {
+        return setThreshold(DEFAULT_THRESHOLD);
+    }
+
+    if (auto ratio = m_target.update(status); ratio) {
+        // larger elements select coarser LoDs
+        return setThreshold(*ratio > 1.0 ? m_threshold * STEP : m_threshold / STEP);
+    }
+    return false;
+}
+
+float LoDController::getThreshold() const
+{
+    return m_threshold;
+}
+
+LoDSelectionParams LoDController::getParams() const
+{
+    LoDSelectionParams params{.method = LoDSelectionMethod::FirstBelowThreshold};
+    params.threshold.minElementSize = m_threshold;
+    return params;
+}
+
+bool LoDController::setThreshold(float threshold)
+{
+    threshold = std::clamp(threshold, MIN_THRESHOLD, MAX_THRESHOLD);
+    if (threshold == m_threshold) {
+        return false;
+    }
+    m_threshold = threshold;
+    m_target.settle();
+    return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "FrameTimeTarget.hpp"
+#include "Status.hpp"
+
+#include "Vitrae/Data/LevelOfDetail.hpp"
+
+#include <chrono>
+
+using namespace Vitrae;
+
+/**
+ * Adjusts the LoD threshold to keep the average frame duration near a target,
+ * one step per average that is off
+ */
+class LoDController
+{
+  public:
+    // the minimum projected element size, in pixels, used without a target
+    static constexpr float DEFAULT_THRESHOLD = 2.0f;
+    static constexpr float MIN_THRESHOLD = 1.0f;
+    static constexpr float MAX_THRESHOLD = 64.0f;
+    // factor the threshold changes by in one step
+    static constexpr float STEP = 1.25f;
+
+    // a zero target keeps the default threshold
+    LoDController(std::chrono::duration<double> targetFrameDuration);
+
+    void setTarget(std::chrono::duration<double> targetFrameDuration);
+    std::chrono::duration<double> getTarget() const;
+
+    // to be called after each Status update; @returns whether the threshold changed
+    bool update(const Status &status);
+
+    float getThreshold() const;
+    LoDSelectionParams getParams() const;
+
+  private:
+    FrameTimeTarget m_target;
+    float m_threshold;
+
+    bool setThreshold(float threshold);
+};
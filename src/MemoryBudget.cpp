@@ -0,0 +1,89 @@
+#include "MemoryBudget.hpp"
+
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+MemoryBudget::MemoryBudget(std::size_t budgetBytes) : m_evictionBackoff(SAMPLE_INTERVAL)
+{
+    m_stats.budgetBytes = budgetBytes;
+    m_stats.residentBytes = residentBytes();
+}
+
+void MemoryBudget::setBudget(std::size_t budgetBytes)
+{
+    m_stats.budgetBytes = budgetBytes;
+}
+
+bool MemoryBudget::hasBudget() const
+{
+    return m_stats.budgetBytes > 0;
+}
+
+void MemoryBudget::update(ComponentRoot &root)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - m_lastSampleTime < SAMPLE_INTERVAL) {
+        return;
+    }
+    m_lastSampleTime = now;
+
+    m_stats.residentBytes = residentBytes();
+    m_stats.sampleCount++;
+
+    // memory outside of the pools can keep the process over budget, evicting wouldn't help then
+    if (hasBudget() && m_stats.residentBytes > m_stats.budgetBytes && now >= m_nextEvictionTime) {
+        if (evict(root, m_stats.residentBytes - m_stats.budgetBytes)) {
+            m_evictionBackoff = SAMPLE_INTERVAL;
+        } else {
+            m_evictionBackoff = std::min(m_evictionBackoff * 2, MAX_EVICTION_BACKOFF);
+        }
+        m_nextEvictionTime = now + m_evictionBackoff;
+    }
+}
+
+void MemoryBudget::freeUnused(ComponentRoot &root)
+{
+    evict(root, std::numeric_limits<std::size_t>::max());
+}
+
+MemoryBudget::Stats MemoryBudget::getStats() const
+{
+    return m_stats;
+}
+
+std::size_t MemoryBudget::residentBytes()
+{
+#ifdef __linux__
+    // fields are counted in pages: total size, then resident size
+    std::ifstream statm("/proc/self/statm");
+    std::size_t totalPages, residentPages;
+    if (statm >> totalPages >> residentPages) {
+        return residentPages * (std::size_t)sysconf(_SC_PAGESIZE);
+    }
+#endif
+    return 0;
+}
+
+bool MemoryBudget::evict(ComponentRoot &root, std::size_t bytes)
+{
+    PROFILE_SCOPE("Memory eviction");
+
+    std::size_t residentBefore = residentBytes();
+    root.cleanMemoryPools(bytes);
+    std::size_t residentAfter = residentBytes();
+
+    m_stats.residentBytes = residentAfter;
+    if (residentAfter >= residentBefore) {
+        return false;
+    }
+    m_stats.evictionCount++;
+    m_stats.evictedBytes += residentBefore - residentAfter;
+    return true;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Vitrae/Collections/ComponentRoot.hpp"
+
+#include <chrono>
+#include <cstddef>
+
+using namespace Vitrae;
+
+/**
+ * Keeps the process memory under a budget by evicting unused assets from the memory pools.
+ * Without a budget, unused assets are freed only when a new pipeline takes over (as before).
+ * The engine's pools don't report their sizes, so the process RSS stands in for them;
+ * it misses GPU memory, and freed heap memory often stays resident
+ */
+class MemoryBudget
+{
+  public:
+    struct Stats
+    {
+        std::size_t residentBytes = 0;
+        std::size_t budgetBytes = 0;
+        // evictions that lowered the resident memory
+        std::size_t evictionCount = 0;
+        std::size_t evictedBytes = 0;
+        // increments with every new residentBytes sample
+        std::size_t sampleCount = 0;
+    };
+
+    static constexpr std::chrono::milliseconds SAMPLE_INTERVAL{500};
+    // the longest wait after evictions that freed nothing, e.g. when the pools are already empty
+    static constexpr std::chrono::milliseconds MAX_EVICTION_BACKOFF{32000};
+
+    MemoryBudget(std::size_t budgetBytes);
+
+    // 0 means no budget
+    void setBudget(std::size_t budgetBytes);
+    bool hasBudget() const;
+
+    // samples the memory usage and evicts if over budget; cheap to call every frame
+    void update(ComponentRoot &root);
+    // frees every unused pooled asset
+    void freeUnused(ComponentRoot &root);
+
+    Stats getStats() const;
+
+    // resident memory of the process, or 0 where it can't be measured
+    static std::size_t residentBytes();
+
+  private:
+    Stats m_stats;
+    std::chrono::steady_clock::time_point m_lastSampleTime;
+    // doubled by each eviction that freed nothing, reset by one that freed memory
+    std::chrono::milliseconds m_evictionBackoff;
+    std::chrono::steady_clock::time_point m_nextEvictionTime;
+
+    // @returns whether the resident memory went down
+    bool evict(ComponentRoot &root, std::size_t bytes);
+};
@@ -0,0 +1,323 @@
+#include "OcclusionCuller.hpp"
+
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define OCCLUSION_USE_SSE
+#endif
+
+namespace
+{
+// corner indices of the box faces; bit 0 of an index selects the max x, bit 1 y and bit 2 z
+constexpr std::array<std::array<int, 4>, 6> BOX_FACES = {{
+    {0, 2, 6, 4},
+    {1, 3, 7, 5},
+    {0, 1, 5, 4},
+    {2, 3, 7, 6},
+    {0, 1, 3, 2},
+    {4, 5, 7, 6},
+}};
+
+// coefficients of the edge function A*x + B*y + C, positive on the inner side of the edge
+struct EdgeFunction
+{
+    float a, b, c;
+
+    EdgeFunction(glm::vec3 from, glm::vec3 to)
+        : a(from.y - to.y), b(to.x - from.x), c((to.y - from.y) * from.x - (to.x - from.x) * from.y)
+    {}
+};
+
+bool isSlab(const Bounds &bounds)
+{
+    glm::vec3 size = bounds.max - bounds.min;
+    return std::min({size.x, size.y, size.z}) <=
+           std::max({size.x, size.y, size.z}) * OcclusionCuller::MAX_OCCLUDER_THICKNESS;
+}
+
+// the bounds shrunk around the center along all but the thinnest axis
+Bounds occluderCore(const Bounds &bounds)
+{
+    glm::vec3 size = bounds.max - bounds.min;
+    int thinnestAxis = size.x <= size.y && size.x <= size.z ? 0 : size.y <= size.z ? 1 : 2;
+    glm::vec3 margin = size * ((1.0f - OcclusionCuller::OCCLUDER_CORE_FRACTION) * 0.5f);
+    margin[thinnestAxis] = 0.0f;
+
+    Bounds core;
+    core.min = bounds.min + margin;
+    core.max = bounds.max - margin;
+    return core;
+}
+} // namespace
+
+OcclusionCuller::OcclusionCuller()
+{
+    std::size_t width = DEPTH_WIDTH;
+    std::size_t height = DEPTH_HEIGHT;
+    m_depthLevels.emplace_back(width * height, 1.0f);
+    while (width > 1 || height > 1) {
+        width = std::max<std::size_t>(width / 2, 1);
+        height = std::max<std::size_t>(height / 2, 1);
+        m_depthLevels.emplace_back(width * height, 1.0f);
+    }
+}
+
+void OcclusionCuller::cull(Scene &scene, const glm::mat4 &viewProjection)
+{
+    PROFILE_SCOPE("Occlusion culling");
+
+    auto &props = scene.modelProps;
+    auto startTime = std::chrono::steady_clock::now();
+
+    {
+        PROFILE_SCOPE("Occluder rasterization");
+
+        auto screenArea = [&](const ScreenRect &rect) {
+            glm::vec2 size = glm::clamp(rect.max, glm::vec2(0.0f),
+                                        glm::vec2(DEPTH_WIDTH, DEPTH_HEIGHT)) -
+                             glm::clamp(rect.min, glm::vec2(0.0f),
+                                        glm::vec2(DEPTH_WIDTH, DEPTH_HEIGHT));
+            return std::max(size.x, 0.0f) * std::max(size.y, 0.0f);
+        };
+
+        m_rects.resize(props.size());
+        m_occluders.clear();
+        for (std::size_t i = 0; i < props.size(); i++) {
+            Bounds bounds = propBounds(props[i]);
+            m_rects[i] = project(bounds, viewProjection);
+            if (m_rects[i].inFront && isSlab(bounds) &&
+                screenArea(m_rects[i]) >=
+                    MIN_OCCLUDER_SCREEN_FRACTION * DEPTH_WIDTH * DEPTH_HEIGHT) {
+                m_occluders.push_back((std::uint32_t)i);
+            }
+        }
+
+        // the largest occluders hide the most
+        std::size_t occluderCount = std::min(m_occluders.size(), MAX_OCCLUDERS);
+        std::partial_sort(m_occluders.begin(), m_occluders.begin() + occluderCount,
+                          m_occluders.end(), [&](std::uint32_t a, std::uint32_t b) {
+                              return screenArea(m_rects[a]) > screenArea(m_rects[b]);
+                          });
+        m_occluders.resize(occluderCount);
+
+        std::fill(m_depthLevels[0].begin(), m_depthLevels[0].end(), 1.0f);
+        for (std::uint32_t occluder : m_occluders) {
+            // only the core is assumed solid; the full bounds picked the occluder
+            ScreenRect coreRect =
+                project(occluderCore(propBounds(props[occluder])), viewProjection);
+            if (coreRect.inFront) {
+                rasterizeBox(coreRect);
+            }
+        }
+        buildHierarchy();
+    }
+
+    auto rasterizedTime = std::chrono::steady_clock::now();
+
+    std::size_t keptCount = 0;
+    {
+        PROFILE_SCOPE("Occlusion test");
+
+        for (std::size_t i = 0; i < props.size(); i++) {
+            if (!isOccluded(m_rects[i])) {
+                if (keptCount != i) {
+                    props[keptCount] = std::move(props[i]);
+                }
+                keptCount++;
+            }
+        }
+    }
+    std::size_t testedCount = props.size();
+    props.erase(props.begin() + keptCount, props.end());
+
+    auto endTime = std::chrono::steady_clock::now();
+
+    m_stats = Stats{
+        .occluderCount = m_occluders.size(),
+        .testedCount = testedCount,
+        .occludedCount = testedCount - keptCount,
+        .rasterizeDuration = rasterizedTime - startTime,
+        .testDuration = endTime - rasterizedTime,
+    };
+}
+
+OcclusionCuller::Stats OcclusionCuller::getStats() const
+{
+    return m_stats;
+}
+
+OcclusionCuller::ScreenRect OcclusionCuller::project(const Bounds &bounds,
+                                                     const glm::mat4 &viewProjection) const
+{
+    ScreenRect rect{
+        .min = glm::vec2(std::numeric_limits<float>::max()),
+        .max = glm::vec2(std::numeric_limits<float>::lowest()),
+        .nearestDepth = std::numeric_limits<float>::max(),
+        .inFront = true,
+    };
+
+    for (int i = 0; i < 8; i++) {
+        glm::vec4 corner((i & 1) ? bounds.max.x : bounds.min.x,
+                         (i & 2) ? bounds.max.y : bounds.min.y,
+                         (i & 4) ? bounds.max.z : bounds.min.z, 1.0f);
+        glm::vec4 clip = viewProjection * corner;
+        // bounds crossing the near plane can't be projected
+        if (clip.w <= 0.0f || clip.z < -clip.w) {
+            rect.inFront = false;
+            return rect;
+        }
+
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        glm::vec3 screen((ndc.x * 0.5f + 0.5f) * DEPTH_WIDTH, (ndc.y * 0.5f + 0.5f) * DEPTH_HEIGHT,
+                         ndc.z * 0.5f + 0.5f);
+        rect.corners[i] = screen;
+        rect.min = glm::min(rect.min, glm::vec2(screen));
+        rect.max = glm::max(rect.max, glm::vec2(screen));
+        rect.nearestDepth = std::min(rect.nearestDepth, screen.z);
+    }
+    return rect;
+}
+
+void OcclusionCuller::rasterizeBox(const ScreenRect &rect)
+{
+    for (auto &face : BOX_FACES) {
+        rasterizeTriangle(rect.corners[face[0]], rect.corners[face[1]], rect.corners[face[2]]);
+        rasterizeTriangle(rect.corners[face[0]], rect.corners[face[2]], rect.corners[face[3]]);
+    }
+}
+
+void OcclusionCuller::rasterizeTriangle(glm::vec3 v0, glm::vec3 v1, glm::vec3 v2)
+{
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+    if (std::abs(area) < 1e-6f) {
+        return;
+    }
+    // both sides are rasterized; the nearer depth wins anyway
+    if (area < 0.0f) {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    // each edge function is the weight of the opposite vertex, scaled by the area
+    EdgeFunction edge0(v1, v2), edge1(v2, v0), edge2(v0, v1);
+    float depthA = (edge0.a * v0.z + edge1.a * v1.z + edge2.a * v2.z) / area;
+    float depthB = (edge0.b * v0.z + edge1.b * v1.z + edge2.b * v2.z) / area;
+    float depthC = (edge0.c * v0.z + edge1.c * v1.z + edge2.c * v2.z) / area;
+
+    int minX = std::max((int)std::floor(std::min({v0.x, v1.x, v2.x})), 0);
+    int maxX = std::min((int)std::ceil(std::max({v0.x, v1.x, v2.x})), (int)DEPTH_WIDTH - 1);
+    int minY = std::max((int)std::floor(std::min({v0.y, v1.y, v2.y})), 0);
+    int maxY = std::min((int)std::ceil(std::max({v0.y, v1.y, v2.y})), (int)DEPTH_HEIGHT - 1);
+    // rows are processed in groups of 4 pixels
+    minX &= ~3;
+
+    std::vector<float> &depth = m_depthLevels[0];
+    for (int y = minY; y <= maxY; y++) {
+        float pixelY = y + 0.5f;
+        float *row = depth.data() + y * DEPTH_WIDTH;
+        float rowC0 = edge0.b * pixelY + edge0.c;
+        float rowC1 = edge1.b * pixelY + edge1.c;
+        float rowC2 = edge2.b * pixelY + edge2.c;
+        float rowDepthC = depthB * pixelY + depthC;
+
+#ifdef OCCLUSION_USE_SSE
+        __m128 zero = _mm_setzero_ps();
+        for (int x = minX; x <= maxX; x += 4) {
+            __m128 pixelX = _mm_add_ps(_mm_set1_ps(x + 0.5f), _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f));
+            __m128 weight0 =
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge0.a), pixelX), _mm_set1_ps(rowC0));
+            __m128 weight1 =
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge1.a), pixelX), _mm_set1_ps(rowC1));
+            __m128 weight2 =
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(edge2.a), pixelX), _mm_set1_ps(rowC2));
+            __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(weight0, zero),
+                                                  _mm_cmpge_ps(weight1, zero)),
+                                       _mm_cmpge_ps(weight2, zero));
+            if (_mm_movemask_ps(inside) == 0) {
+                continue;
+            }
+
+            __m128 pixelDepth =
+                _mm_add_ps(_mm_mul_ps(_mm_set1_ps(depthA), pixelX), _mm_set1_ps(rowDepthC));
+            __m128 current = _mm_loadu_ps(row + x);
+            __m128 nearer = _mm_min_ps(current, pixelDepth);
+            _mm_storeu_ps(row + x,
+                          _mm_or_ps(_mm_and_ps(inside, nearer), _mm_andnot_ps(inside, current)));
+        }
+#else
+        for (int x = minX; x <= maxX; x++) {
+            float pixelX = x + 0.5f;
+            if (edge0.a * pixelX + rowC0 >= 0.0f && edge1.a * pixelX + rowC1 >= 0.0f &&
+                edge2.a * pixelX + rowC2 >= 0.0f) {
+                row[x] = std::min(row[x], depthA * pixelX + rowDepthC);
+            }
+        }
+#endif
+    }
+}
+
+void OcclusionCuller::buildHierarchy()
+{
+    std::size_t prevWidth = DEPTH_WIDTH;
+    std::size_t prevHeight = DEPTH_HEIGHT;
+    for (std::size_t level = 1; level < m_depthLevels.size(); level++) {
+        const std::vector<float> &prev = m_depthLevels[level - 1];
+        std::vector<float> &current = m_depthLevels[level];
+        std::size_t width = std::max<std::size_t>(prevWidth / 2, 1);
+        std::size_t height = std::max<std::size_t>(prevHeight / 2, 1);
+
+        for (std::size_t y = 0; y < height; y++) {
+            std::size_t y0 = std::min(2 * y, prevHeight - 1);
+            std::size_t y1 = std::min(2 * y + 1, prevHeight - 1);
+            for (std::size_t x = 0; x < width; x++) {
+                std::size_t x0 = std::min(2 * x, prevWidth - 1);
+                std::size_t x1 = std::min(2 * x + 1, prevWidth - 1);
+                current[y * width + x] =
+                    std::max({prev[y0 * prevWidth + x0], prev[y0 * prevWidth + x1],
+                              prev[y1 * prevWidth + x0], prev[y1 * prevWidth + x1]});
+            }
+        }
+
+        prevWidth = width;
+        prevHeight = height;
+    }
+}
+
+bool OcclusionCuller::isOccluded(const ScreenRect &rect) const
+{
+    if (!rect.inFront) {
+        return false;
+    }
+
+    glm::vec2 screenMax(DEPTH_WIDTH - 1, DEPTH_HEIGHT - 1);
+    glm::vec2 min = glm::clamp(rect.min, glm::vec2(0.0f), screenMax);
+    glm::vec2 max = glm::clamp(rect.max, glm::vec2(0.0f), screenMax);
+    // off-screen props are left to the frustum culling
+    if (rect.max.x < 0.0f || rect.max.y < 0.0f || rect.min.x > screenMax.x ||
+        rect.min.y > screenMax.y) {
+        return false;
+    }
+
+    // the level at which the rect covers at most 2x2 texels
+    float size = std::max({max.x - min.x, max.y - min.y, 1.0f});
+    std::size_t level =
+        std::min((std::size_t)std::ceil(std::log2(size)), m_depthLevels.size() - 1);
+    std::size_t width = std::max<std::size_t>(DEPTH_WIDTH >> level, 1);
+    std::size_t height = std::max<std::size_t>(DEPTH_HEIGHT >> level, 1);
+
+    const std::vector<float> &depth = m_depthLevels[level];
+    float farthestDepth = 0.0f;
+    for (std::size_t y = std::min((std::size_t)min.y >> level, height - 1);
+         y <= std::min((std::size_t)max.y >> level, height - 1); y++) {
+        for (std::size_t x = std::min((std::size_t)min.x >> level, width - 1);
+             x <= std::min((std::size_t)max.x >> level, width - 1); x++) {
+            farthestDepth = std::max(farthestDepth, depth[y * width + x]);
+        }
+    }
+    return rect.nearestDepth > farthestDepth;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Bounds.hpp"
+
+#include "Vitrae/Assets/Scene.hpp"
+
+#include "glm/glm.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace Vitrae;
+
+/**
+ * Removes the props hidden behind large occluders from the scene, entirely on the CPU.
+ * The occluders are rasterized into a small depth buffer, whose hierarchy of farthest depths
+ * the bounds of the remaining props are tested against.
+ * Occluders are approximated by their bounding boxes, so only slab-shaped props
+ * (walls, floors) are chosen as occluders, and only the central part of their bounds is
+ * rasterized. That still over-estimates props with holes in the middle (a wall with a window),
+ * so visible props can get culled
+ */
+class OcclusionCuller
+{
+  public:
+    struct Stats
+    {
+        std::size_t occluderCount = 0;
+        std::size_t testedCount = 0;
+        std::size_t occludedCount = 0;
+        std::chrono::duration<double> rasterizeDuration{0.0};
+        std::chrono::duration<double> testDuration{0.0};
+    };
+
+    // the width is a multiple of 4, for rasterizing 4 pixels at once
+    static constexpr std::size_t DEPTH_WIDTH = 256;
+    static constexpr std::size_t DEPTH_HEIGHT = 128;
+    static constexpr std::size_t MAX_OCCLUDERS = 32;
+    // fraction of the screen the bounds of an occluder must cover
+    static constexpr float MIN_OCCLUDER_SCREEN_FRACTION = 0.01f;
+    // the thinnest side of an occluder's bounds relative to its largest side
+    static constexpr float MAX_OCCLUDER_THICKNESS = 0.2f;
+    // part of the two largest sides of an occluder's bounds that is rasterized,
+    // so table legs, fence gaps and tilted props don't count as solid
+    static constexpr float OCCLUDER_CORE_FRACTION = 0.5f;
+
+    OcclusionCuller();
+
+    // removes the occluded props from the scene
+    void cull(Scene &scene, const glm::mat4 &viewProjection);
+
+    Stats getStats() const;
+
+  private:
+    // bounds of a prop projected onto the depth buffer
+    struct ScreenRect
+    {
+        glm::vec2 min;
+        glm::vec2 max;
+        float nearestDepth;
+        // projected positions of the corners, if they're all in front of the camera
+        std::array<glm::vec3, 8> corners;
+        bool inFront;
+    };
+
+    // level 0 is the rasterized depth, each next level has the farthest depth of 2x2 texels
+    std::vector<std::vector<float>> m_depthLevels;
+    std::vector<ScreenRect> m_rects;
+    std::vector<std::uint32_t> m_occluders;
+    Stats m_stats;
+
+    ScreenRect project(const Bounds &bounds, const glm::mat4 &viewProjection) const;
+    void rasterizeBox(const ScreenRect &rect);
+    void rasterizeTriangle(glm::vec3 v0, glm::vec3 v1, glm::vec3 v2);
+    void buildHierarchy();
+    bool isOccluded(const ScreenRect &rect) const;
+};
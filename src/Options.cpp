@@ -0,0 +1,366 @@
+#include "Options.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+namespace
+{
+std::vector<std::string> split(std::string_view str, char separator)
+{
+    std::vector<std::string> parts;
+    std::size_t start = 0;
+    while (true) {
+        std::size_t end = str.find(separator, start);
+        parts.emplace_back(str.substr(start, end - start));
+        if (end == std::string_view::npos) {
+            break;
+        }
+        start = end + 1;
+    }
+    return parts;
+}
+
+std::size_t parseCount(std::string_view flag, const std::string &str)
+{
+    try {
+        std::size_t pos;
+        unsigned long long val = std::stoull(str, &pos);
+        if (pos != str.size()) {
+            throw std::invalid_argument(str);
+        }
+        return val;
+    }
+    catch (const std::logic_error &) {
+        throw std::invalid_argument(std::string(flag) + " expects a whole number, got '" + str +
+                                    "'");
+    }
+}
+
+double parseNumber(std::string_view flag, const std::string &str)
+{
+    try {
+        std::size_t pos;
+        double val = std::stod(str, &pos);
+        if (pos != str.size()) {
+            throw std::invalid_argument(str);
+        }
+        return val;
+    }
+    catch (const std::logic_error &) {
+        throw std::invalid_argument(std::string(flag) + " expects a number, got '" + str + "'");
+    }
+}
+} // namespace
+
+std::size_t Amplification::copyCount() const
+{
+    switch (layout) {
+    case Layout::Grid:
+        return gridSize[0] * gridSize[1] * gridSize[2];
+    case Layout::Scatter:
+        return scatterCount;
+    default:
+        return 1;
+    }
+}
+
+Options::Options(int argc, char **argv)
+{
+    std::size_t positionalIndex = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+
+        auto nextArg = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument(std::string(arg) + " expects a value");
+            }
+            return argv[++i];
+        };
+
+        if (arg == "--bake-scene") {
+            bakeScene = true;
+        } else if (arg == "--no-scene-cache") {
+            useSceneCache = false;
+        } else if (arg == "--amplify-grid") {
+            std::string size = nextArg();
+            auto counts = split(size, 'x');
+            if (counts.size() != 3) {
+                throw std::invalid_argument("--amplify-grid expects <n>x<m>x<k>");
+            }
+            for (std::size_t axis = 0; axis < 3; axis++) {
+                amplification.gridSize[axis] = parseCount(arg, counts[axis]);
+            }
+            amplification.layout = Amplification::Layout::Grid;
+        } else if (arg == "--amplify-scatter") {
+            amplification.scatterCount = parseCount(arg, nextArg());
+            amplification.layout = Amplification::Layout::Scatter;
+        } else if (arg == "--amplify-seed") {
+            amplification.seed = parseCount(arg, nextArg());
+        } else if (arg == "--amplify-jitter") {
+            amplification.jitter = parseNumber(arg, nextArg());
+        } else if (arg == "--amplify-spacing") {
+            amplification.spacing = parseNumber(arg, nextArg());
+        } else if (arg == "--frustum-culling") {
+            frustumCulling = true;
+        } else if (arg == "--occlusion-culling") {
+            occlusionCulling = true;
+            frustumCulling = true;
+        } else if (arg == "--gui-rate") {
+            guiRefreshRate = parseNumber(arg, nextArg());
+        } else if (arg == "--frame-limit") {
+            frameRateLimit = parseNumber(arg, nextArg());
+        } else if (arg == "--vsync") {
+            vsync = true;
+        } else if (arg == "--headless") {
+            headless = true;
+        } else if (arg == "--warmup") {
+            warmupFrames = parseCount(arg, nextArg());
+        } else if (arg == "--frames") {
+            measuredFrames = parseCount(arg, nextArg());
+        } else if (arg == "--width") {
+            frameWidth = parseCount(arg, nextArg());
+        } else if (arg == "--height") {
+            frameHeight = parseCount(arg, nextArg());
+        } else if (arg == "--report") {
+            reportPath = nextArg();
+        } else if (arg == "--inject-input") {
+            inputInjectionRate = parseNumber(arg, nextArg());
+        } else if (arg == "--sweep") {
+            sweep = true;
+            headless = true;
+        } else if (arg == "--sweep-only") {
+            std::string filter = nextArg();
+            std::size_t eqPos = filter.find('=');
+            if (eqPos == std::string::npos || eqPos == 0 || eqPos + 1 == filter.size()) {
+                throw std::invalid_argument("--sweep-only expects <name>=<option>[,<option>...]");
+            }
+            auto &sweptOptions = sweepFilters[filter.substr(0, eqPos)];
+            for (auto &option : split(std::string_view(filter).substr(eqPos + 1), ',')) {
+                sweptOptions.push_back(option);
+            }
+        } else if (arg == "--explore") {
+            std::string range = nextArg();
+            std::size_t eqPos = range.find('=');
+            auto bounds = eqPos == std::string::npos
+                              ? std::vector<std::string>()
+                              : split(std::string_view(range).substr(eqPos + 1), ':');
+            if (eqPos == 0 || bounds.size() < 2 || bounds.size() > 3) {
+                throw std::invalid_argument("--explore expects <input>=<from>:<to>[:<steps>]");
+            }
+            ExploreRange &exploreRange = exploreRanges.emplace_back(ExploreRange{
+                .name = range.substr(0, eqPos),
+                .from = parseNumber(arg, bounds[0]),
+                .to = parseNumber(arg, bounds[1]),
+            });
+            if (bounds.size() == 3) {
+                exploreRange.steps = parseCount(arg, bounds[2]);
+                if (exploreRange.steps < 2) {
+                    throw std::invalid_argument("--explore needs at least 2 steps");
+                }
+            }
+            headless = true;
+        } else if (arg == "--compare") {
+            auto &overrides = comparisons.emplace_back();
+            for (auto &choice : split(nextArg(), ',')) {
+                std::size_t eqPos = choice.find('=');
+                if (eqPos == std::string::npos || eqPos == 0 || eqPos + 1 == choice.size()) {
+                    throw std::invalid_argument(
+                        "--compare expects <name>=<option>[,<name>=<option>...]");
+                }
+                overrides[choice.substr(0, eqPos)] = choice.substr(eqPos + 1);
+            }
+        } else if (arg == "--lod-target") {
+            lodTarget = parseNumber(arg, nextArg());
+        } else if (arg == "--dynamic-resolution") {
+            resolutionTarget = parseNumber(arg, nextArg());
+        } else if (arg == "--resolution-bounds") {
+            auto bounds = split(nextArg(), ':');
+            if (bounds.size() != 2) {
+                throw std::invalid_argument("--resolution-bounds expects <min>:<max>");
+            }
+            minResolutionScale = parseNumber(arg, bounds[0]);
+            maxResolutionScale = parseNumber(arg, bounds[1]);
+        } else if (arg == "--trace") {
+            tracePath = nextArg();
+        } else if (arg == "--trace-seconds") {
+            traceDuration = std::chrono::duration<double>(parseNumber(arg, nextArg()));
+        } else if (arg == "--camera-path") {
+            cameraPathPath = nextArg();
+        } else if (arg == "--record-camera-path") {
+            recordCameraPathPath = nextArg();
+        } else if (arg == "--record-interval") {
+            recordInterval = parseCount(arg, nextArg());
+        } else if (arg == "--pipeline-cache") {
+            pipelineCacheSize = parseCount(arg, nextArg());
+        } else if (arg == "--shader-cache") {
+            shaderCachePath = nextArg();
+        } else if (arg == "--no-shader-cache") {
+            shaderCache = false;
+        } else if (arg == "--memory-budget") {
+            memoryBudget = parseCount(arg, nextArg());
+        } else if (arg.starts_with("--")) {
+            throw std::invalid_argument("Unknown option " + std::string(arg));
+        } else {
+            switch (positionalIndex++) {
+            case 0:
+                scenePath = arg;
+                break;
+            case 1:
+                sceneScale = (float)parseNumber("scene scale", std::string(arg));
+                break;
+            default:
+                throw std::invalid_argument("Unexpected argument " + std::string(arg));
+            }
+        }
+    }
+
+    if (scenePath.empty()) {
+        throw std::invalid_argument("Missing scene path");
+    }
+    if (frameWidth == 0 || frameHeight == 0) {
+        throw std::invalid_argument("Frame size must be non-zero");
+    }
+    if (!(guiRefreshRate > 0.0)) {
+        throw std::invalid_argument("GUI refresh rate must be positive");
+    }
+    if (frameRateLimit < 0.0) {
+        throw std::invalid_argument("Frame rate limit can't be negative");
+    }
+    if (vsync && frameRateLimit > 0.0) {
+        throw std::invalid_argument("--vsync and --frame-limit can't be combined");
+    }
+    if (vsync && headless) {
+        throw std::invalid_argument("--vsync needs a window, so it can't be used headless");
+    }
+    if (inputInjectionRate < 0.0) {
+        throw std::invalid_argument("Input injection rate can't be negative");
+    }
+    if (inputInjectionRate > 0.0 && !headless) {
+        // the window's events come from the same thread as the GUI's commands
+        throw std::invalid_argument("--inject-input is only available headless");
+    }
+    if (inputInjectionRate > 0.0 && (sweep || !exploreRanges.empty())) {
+        // the drags would move the camera between the captured frames that get compared
+        throw std::invalid_argument("--inject-input can't be combined with --sweep or --explore");
+    }
+    if (!shaderCache && !shaderCachePath.empty()) {
+        throw std::invalid_argument("--shader-cache and --no-shader-cache can't be combined");
+    }
+    if (bakeScene && !useSceneCache) {
+        throw std::invalid_argument("--bake-scene and --no-scene-cache can't be combined");
+    }
+    if (amplification.copyCount() == 0) {
+        throw std::invalid_argument("Amplification needs at least one copy");
+    }
+    if (amplification.jitter < 0.0 || amplification.spacing < 0.0) {
+        throw std::invalid_argument("Amplification jitter and spacing can't be negative");
+    }
+    if (sweep && !exploreRanges.empty()) {
+        throw std::invalid_argument("--sweep and --explore can't be combined");
+    }
+    if (!sweepFilters.empty() && !sweep) {
+        throw std::invalid_argument("--sweep-only needs --sweep");
+    }
+    if (lodTarget < 0.0) {
+        throw std::invalid_argument("LoD target frame time can't be negative");
+    }
+    if (resolutionTarget < 0.0) {
+        throw std::invalid_argument("Dynamic resolution target frame time can't be negative");
+    }
+    if (!(minResolutionScale > 0.0 && minResolutionScale <= maxResolutionScale)) {
+        throw std::invalid_argument("Resolution bounds must be positive and ordered");
+    }
+    if (!(traceDuration.count() > 0.0)) {
+        throw std::invalid_argument("Trace duration must be positive");
+    }
+    if (recordInterval == 0) {
+        throw std::invalid_argument("Recording interval must be non-zero");
+    }
+}
+
+std::string Options::usage(const char *programName)
+{
+    std::stringstream ss;
+    ss << "Usage: " << programName << " <scene path> [scene scale] [options]" << std::endl
+       << "Options:" << std::endl
+       << "  --bake-scene                 write a binary copy of the scene for faster loading"
+       << std::endl
+       << "  --no-scene-cache             load the source scene even if a baked copy exists"
+       << std::endl
+       << "  --amplify-grid <n>x<m>x<k>   replicate the scene into a grid of copies" << std::endl
+       << "  --amplify-scatter <n>        replicate the scene into n randomly placed copies"
+       << std::endl
+       << "  --amplify-seed <n>           random seed of the scatter and jitter (default 1)"
+       << std::endl
+       << "  --amplify-jitter <fraction>  random offset of the copies, relative to the spacing"
+       << std::endl
+       << "  --amplify-spacing <units>    distance between copies (default: the scene extent)"
+       << std::endl
+       << "  --frustum-culling            render only the props inside the view frustum"
+       << std::endl
+       << "  --occlusion-culling          also skip props hidden behind walls and floors"
+       << std::endl
+       << "                               (tested on the CPU, implies --frustum-culling;"
+       << std::endl
+       << "                               approximate, can drop visible props)" << std::endl
+       << "  --gui-rate <hz>              how often the GUI shows new values (default 30)"
+       << std::endl
+       << "  --frame-limit <hz>           pace the frames to this rate (sleep, then spin)"
+       << std::endl
+       << "  --vsync                      pace the frames to the display refresh" << std::endl
+       << "  --headless                   render offscreen without GUI, write a report and exit"
+       << std::endl
+       << "  --warmup <n>                 number of unmeasured warm-up frames (headless)"
+       << std::endl
+       << "  --frames <n>                 number of measured frames (headless)" << std::endl
+       << "  --width <px>                 offscreen frame width (headless)" << std::endl
+       << "  --height <px>                offscreen frame height (headless)" << std::endl
+       << "  --report <file>              JSON report destination, stdout if omitted" << std::endl
+       << "  --inject-input <hz>          drag the camera this often to measure the input latency"
+       << std::endl
+       << "                               (headless benchmark)" << std::endl
+       << "  --sweep                      benchmark every combination of methods and outputs"
+       << std::endl
+       << "                               (report is a CSV table if the file ends with .csv)"
+       << std::endl
+       << "  --sweep-only <name>=<a,b>    sweep only these options of a method or the output"
+       << std::endl
+       << "  --explore <input>=<a>:<b>[:<n>]" << std::endl
+       << "                               explore the frame time and image quality of a"
+       << std::endl
+       << "                               compositor input from a to the reference value b"
+       << std::endl
+       << "  --compare <name>=<option>[,...]" << std::endl
+       << "                               also render the configuration with these method"
+       << std::endl
+       << "                               options (or output) beside the main one; repeatable"
+       << std::endl
+       << "  --lod-target <ms>            adjust the level of detail to this frame time"
+       << std::endl
+       << "  --dynamic-resolution <ms>    scale the render resolution to this frame time"
+       << std::endl
+       << "  --resolution-bounds <a>:<b>  bounds of the resolution scale (default 0.5:1)"
+       << std::endl
+       << "  --trace <file>               write a Chrome/Perfetto trace on exit (and on F12)"
+       << std::endl
+       << "  --trace-seconds <s>          how much of the latest trace to write (default 10)"
+       << std::endl
+       << "  --camera-path <file>         play back a camera path, one step per frame"
+       << std::endl
+       << "                               (headless: measures exactly one pass of the path)"
+       << std::endl
+       << "  --record-camera-path <file>  record the camera path, saved on exit" << std::endl
+       << "  --record-interval <n>        frames between recorded keyframes" << std::endl
+       << "  --pipeline-cache <n>         number of unused pipelines kept for reuse (default 8)"
+       << std::endl
+       << "  --shader-cache <dir>         on-disk driver shader cache directory" << std::endl
+       << "  --no-shader-cache            disable the driver shader cache, for cold startups"
+       << std::endl
+       << "  --memory-budget <MiB>        evict unused pooled assets above this process RSS"
+       << std::endl
+       << "                               (default 0: free them all on each pipeline change)"
+       << std::endl;
+    return ss.str();
+}
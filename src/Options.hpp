@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Values of a compositor input to explore, from the cheapest to the reference (best quality)
+ */
+struct ExploreRange
+{
+    std::string name;
+    double from;
+    double to;
+    // 0 picks powers of two for power-of-two integer bounds, and 5 steps otherwise
+    std::size_t steps = 0;
+};
+
+/**
+ * Replication of the loaded props into many copies of the scene,
+ * for measuring how the rendering scales with the prop count
+ */
+struct Amplification
+{
+    enum class Layout
+    {
+        None,
+        // copies next to each other along the x, y and z axes
+        Grid,
+        // copies at random positions on the x-z plane
+        Scatter
+    };
+
+    Layout layout = Layout::None;
+    std::array<std::size_t, 3> gridSize = {1, 1, 1};
+    std::size_t scatterCount = 1;
+    std::uint64_t seed = 1;
+    // random offset of each copy along each axis, as a fraction of the spacing
+    double jitter = 0.0;
+    // distance between neighboring copies, derived from the extent of the props if 0
+    double spacing = 0.0;
+
+    std::size_t copyCount() const;
+};
+
+/**
+ * Command line options of the showcase.
+ * The first two positional arguments are the scene path and the (optional) scene scale,
+ * the rest are --flags
+ */
+struct Options
+{
+    std::filesystem::path scenePath;
+    float sceneScale = 1.0f;
+    // baked scene copies
+    bool useSceneCache = true;
+    bool bakeScene = false;
+    Amplification amplification;
+    bool frustumCulling = false;
+    bool occlusionCulling = false;
+
+    // GUI
+    double guiRefreshRate = 30.0;
+
+    // Frame pacing
+    // in Hz; 0 renders uncapped
+    double frameRateLimit = 0.0;
+    bool vsync = false;
+
+    // Headless benchmark mode
+    bool headless = false;
+    std::size_t warmupFrames = 60;
+    std::size_t measuredFrames = 600;
+    std::size_t frameWidth = 800;
+    std::size_t frameHeight = 600;
+    std::filesystem::path reportPath;
+    // synthetic camera drags per second, for measuring the input latency; 0 injects none
+    double inputInjectionRate = 0.0;
+
+    // Sweep over pipeline configurations (implies headless)
+    bool sweep = false;
+    // method property (or "output") -> the only options to sweep over
+    std::map<std::string, std::vector<std::string>> sweepFilters;
+
+    // Quality/cost exploration of compositor inputs (implies headless)
+    std::vector<ExploreRange> exploreRanges;
+
+    // Configurations rendered next to the main one, from the same scene;
+    // each maps method properties (or "output") to the options that differ from the main one
+    std::vector<std::map<std::string, std::string>> comparisons;
+
+    // Level of detail
+    // in ms; 0 keeps a fixed LoD threshold
+    double lodTarget = 0.0;
+
+    // Dynamic resolution
+    // in ms; 0 renders at the display resolution
+    double resolutionTarget = 0.0;
+    // bounds of the scale of each dimension
+    double minResolutionScale = 0.5;
+    double maxResolutionScale = 1.0;
+
+    // Tracing
+    // where to write the trace on exit (and on F12); nothing is written on exit if empty
+    std::filesystem::path tracePath;
+    // how much of the latest trace is written
+    std::chrono::duration<double> traceDuration{10.0};
+
+    // Camera paths
+    std::filesystem::path cameraPathPath;
+    std::filesystem::path recordCameraPathPath;
+    std::size_t recordInterval = 10;
+
+    // Pipelines
+    std::size_t pipelineCacheSize = 8;
+    // driver shader cache directory, the per-user cache directory if empty
+    std::filesystem::path shaderCachePath;
+    bool shaderCache = true;
+
+    // Memory
+    // in MiB; 0 frees all unused pooled assets whenever a new pipeline takes over
+    std::size_t memoryBudget = 0;
+
+    Options() = default;
+    Options(int argc, char **argv);
+
+    static std::string usage(const char *programName);
+};
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+/**
+ * Calls func(i) for every i in [0, count), split into contiguous ranges over hardware threads.
+ * Small counts run on the calling thread, since starting threads would cost more
+ */
+template <class F> void parallelFor(std::size_t count, F &&func, std::size_t minItemsPerThread = 256)
+{
+    std::size_t threadCount =
+        std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                              (count + minItemsPerThread - 1) / minItemsPerThread);
+
+    if (threadCount <= 1) {
+        for (std::size_t i = 0; i < count; i++) {
+            func(i);
+        }
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (std::size_t t = 0; t < threadCount; t++) {
+        std::size_t begin = count * t / threadCount;
+        std::size_t end = count * (t + 1) / threadCount;
+        threads.emplace_back([begin, end, &func]() {
+            for (std::size_t i = begin; i < end; i++) {
+                func(i);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
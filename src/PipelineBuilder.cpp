@@ -0,0 +1,152 @@
+#include "PipelineBuilder.hpp"
+
+#include "Trace.hpp"
+
+#include <iostream>
+
+PipelineBuilder::PipelineBuilder(ComponentRoot &root, std::mutex &engineMutex)
+    : m_root(root), m_engineMutex(engineMutex), m_stopRequested(false), m_building(false),
+      m_waitingForEngine(false), m_generation(0)
+{
+    m_thread = std::thread([this]() { threadLoop(); });
+}
+
+PipelineBuilder::~PipelineBuilder()
+{
+    {
+        std::unique_lock lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_wakeCondition.notify_one();
+    m_thread.join();
+    // the owner is destroyed on the render thread, so the leftovers go with it
+}
+
+void PipelineBuilder::request(const PipelineConfig &config,
+                              const CompositorParameters &parameters)
+{
+    {
+        std::unique_lock lock(m_mutex);
+        m_request.emplace(Request{config, parameters});
+        if (m_result) {
+            m_discarded.push_back(std::move(m_result->p_compositor));
+            m_result.reset();
+        }
+        m_generation++;
+    }
+    m_wakeCondition.notify_one();
+}
+
+void PipelineBuilder::cancel()
+{
+    std::unique_lock lock(m_mutex);
+    m_request.reset();
+    if (m_result) {
+        m_discarded.push_back(std::move(m_result->p_compositor));
+        m_result.reset();
+    }
+    m_generation++;
+}
+
+std::optional<PipelineBuilder::Result> PipelineBuilder::takeResult()
+{
+    std::vector<std::unique_ptr<Compositor>> discarded;
+    std::optional<Result> result;
+    {
+        std::unique_lock lock(m_mutex);
+        std::swap(discarded, m_discarded);
+        result = std::exchange(m_result, std::nullopt);
+    }
+    // the discarded compositors are destroyed outside of the lock
+    return result;
+}
+
+void PipelineBuilder::waitUntilIdle()
+{
+    std::unique_lock lock(m_mutex);
+    m_doneCondition.wait(lock, [this]() { return !m_request && !m_building; });
+}
+
+void PipelineBuilder::yieldEngine()
+{
+    // the render thread would otherwise lock the engine mutex again before the build gets it
+    std::unique_lock lock(m_mutex);
+    m_doneCondition.wait(lock, [this]() { return !m_waitingForEngine; });
+}
+
+bool PipelineBuilder::isBusy() const
+{
+    std::unique_lock lock(m_mutex);
+    return m_request || m_building;
+}
+
+void PipelineBuilder::threadLoop()
+{
+    TraceRecorder::instance().setThreadName("Pipeline builder");
+
+    std::unique_lock lock(m_mutex);
+    while (true) {
+        m_wakeCondition.wait(lock, [this]() { return m_stopRequested || m_request; });
+        if (m_stopRequested) {
+            break;
+        }
+
+        Request request = std::move(*m_request);
+        m_request.reset();
+        m_building = true;
+        m_waitingForEngine = true;
+        std::size_t generation = m_generation;
+        lock.unlock();
+
+        std::unique_ptr<Compositor> p_compositor;
+        std::chrono::high_resolution_clock::time_point startTime;
+        {
+            // only the setup goes through the root's managers, so the frame waits just for it
+            auto engineLock = lockTraced(m_engineMutex, "Wait for engine access");
+            lock.lock();
+            m_waitingForEngine = false;
+            lock.unlock();
+            m_doneCondition.notify_all();
+
+            startTime = std::chrono::high_resolution_clock::now();
+            // only traced; MMeter data of this thread isn't aggregated
+            TraceScope traceScope("Pipeline setup");
+
+            p_compositor = std::make_unique<Compositor>(m_root);
+            p_compositor->parameters = request.parameters;
+            p_compositor->setParamAliases(ParamAliases(request.config.aliases));
+            p_compositor->setDesiredProperties(request.config.desiredOutputs);
+        }
+
+        // rebuildPipeline() only resolves tasks from the method collection, which the plugins
+        // fill before the first build and nothing modifies afterwards; the programs it needs
+        // are compiled lazily on the render thread, at the first compose of the new pipeline
+        bool succeeded = true;
+        {
+            TraceScope traceScope("Pipeline build");
+            try {
+                p_compositor->rebuildPipeline();
+            }
+            catch (const std::exception &e) {
+                std::cerr << "Pipeline build failed: " << e.what() << std::endl;
+                succeeded = false;
+            }
+        }
+        std::chrono::duration<double> buildDuration =
+            std::chrono::high_resolution_clock::now() - startTime;
+
+        lock.lock();
+        m_building = false;
+        // a newer request or a cancel makes this result obsolete
+        if (succeeded && generation == m_generation) {
+            m_result.emplace(Result{
+                .p_compositor = std::move(p_compositor),
+                .config = std::move(request.config),
+                .buildDuration = buildDuration,
+            });
+        } else {
+            m_discarded.push_back(std::move(p_compositor));
+        }
+        m_doneCondition.notify_all();
+    }
+}
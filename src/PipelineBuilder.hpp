@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Vitrae/Assets/Compositor.hpp"
+#include "Vitrae/Collections/ComponentRoot.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+using namespace Vitrae;
+
+using CompositorParameters = decltype(Compositor::parameters);
+
+/**
+ * Everything that determines the structure of a compositor pipeline
+ */
+struct PipelineConfig
+{
+    std::map<String, String> aliases;
+    ParamList desiredOutputs;
+};
+
+/**
+ * Builds compositor pipelines on a background thread,
+ * so the render thread can keep composing with the previous pipeline in the meantime.
+ * Nothing guarantees that the ComponentRoot's asset managers can be used from two threads
+ * at once, so creating and setting up a compositor holds the engine mutex,
+ * which the render thread holds for each frame; the rebuild itself runs without it.
+ * Compositors that aren't handed out are destroyed by takeResult(), on the render thread
+ */
+class PipelineBuilder
+{
+  public:
+    struct Result
+    {
+        std::unique_ptr<Compositor> p_compositor;
+        PipelineConfig config;
+        std::chrono::duration<double> buildDuration;
+    };
+
+    PipelineBuilder(ComponentRoot &root, std::mutex &engineMutex);
+    ~PipelineBuilder();
+
+    /**
+     * Starts building a pipeline. A request that hasn't been started yet is replaced,
+     * since only the newest configuration is of interest
+     * @param parameters are needed to know which inputs are provided externally
+     */
+    void request(const PipelineConfig &config, const CompositorParameters &parameters);
+    // drops the pending request and the result of the build in progress
+    void cancel();
+
+    /**
+     * @returns the built pipeline if one finished since the last call
+     * @note to be called on the render thread, with the engine mutex locked
+     */
+    std::optional<Result> takeResult();
+    // blocks until all requested pipelines are built; without the engine mutex locked
+    void waitUntilIdle();
+    // lets a build that waits for the engine mutex set up its compositor, which is short;
+    // without the engine mutex locked
+    void yieldEngine();
+
+    bool isBusy() const;
+
+  private:
+    ComponentRoot &m_root;
+    std::mutex &m_engineMutex;
+    std::thread m_thread;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_doneCondition;
+    bool m_stopRequested;
+    bool m_building;
+    bool m_waitingForEngine;
+    // incremented by each request and cancel, to recognize obsolete builds
+    std::size_t m_generation;
+
+    struct Request
+    {
+        PipelineConfig config;
+        CompositorParameters parameters;
+    };
+    std::optional<Request> m_request;
+    std::optional<Result> m_result;
+    // obsolete and failed builds, waiting to be destroyed on the render thread
+    std::vector<std::unique_ptr<Compositor>> m_discarded;
+
+    void threadLoop();
+};
@@ -0,0 +1,74 @@
+#include "PipelineCache.hpp"
+
+#include <algorithm>
+#include <set>
+#include <string>
+
+namespace
+{
+std::set<std::string> specNames(const ParamList &specs)
+{
+    std::set<std::string> names;
+    for (auto &spec : specs.getSpecList()) {
+        names.insert(spec.name);
+    }
+    return names;
+}
+} // namespace
+
+PipelineCache::PipelineCache(std::size_t capacity) : m_capacity(capacity)
+{
+    m_stats.capacity = capacity;
+}
+
+std::optional<PipelineBuilder::Result> PipelineCache::take(const PipelineConfig &config)
+{
+    auto it = std::find_if(m_entries.begin(), m_entries.end(),
+                           [&](const auto &entry) { return matches(entry.config, config); });
+    if (it == m_entries.end()) {
+        m_stats.missCount++;
+        return std::nullopt;
+    }
+
+    PipelineBuilder::Result pipeline = std::move(*it);
+    m_entries.erase(it);
+    m_stats.entryCount = m_entries.size();
+    m_stats.hitCount++;
+    m_stats.savedBuildDuration += pipeline.buildDuration;
+    return pipeline;
+}
+
+void PipelineCache::store(PipelineBuilder::Result pipeline)
+{
+    // a newer build of the same config replaces the old one
+    m_entries.remove_if(
+        [&](const auto &entry) { return matches(entry.config, pipeline.config); });
+
+    if (m_capacity > 0) {
+        m_entries.push_front(std::move(pipeline));
+    }
+    while (m_entries.size() > m_capacity) {
+        m_entries.pop_back();
+        m_stats.evictionCount++;
+    }
+    m_stats.entryCount = m_entries.size();
+}
+
+void PipelineCache::clear()
+{
+    m_entries.clear();
+    m_stats.entryCount = 0;
+}
+
+PipelineCache::Stats PipelineCache::getStats() const
+{
+    return m_stats;
+}
+
+bool PipelineCache::matches(const PipelineConfig &a, const PipelineConfig &b)
+{
+    // the input specs follow from these two,
+    // and pipelines built before their inputs got defaults are never cached;
+    // the outputs are compared by name, since toggling them in the settings changes their order
+    return a.aliases == b.aliases && specNames(a.desiredOutputs) == specNames(b.desiredOutputs);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "PipelineBuilder.hpp"
+
+#include <chrono>
+#include <list>
+#include <optional>
+
+/**
+ * Least-recently-used cache of built compositor pipelines.
+ * Keeping a compositor alive keeps its shaders and buffers referenced,
+ * so switching back to a cached configuration needs neither a rebuild nor a recompilation
+ */
+class PipelineCache
+{
+  public:
+    struct Stats
+    {
+        std::size_t entryCount = 0;
+        std::size_t capacity = 0;
+        std::size_t hitCount = 0;
+        std::size_t missCount = 0;
+        std::size_t evictionCount = 0;
+        // sum of the original build durations of all hits
+        std::chrono::duration<double> savedBuildDuration{0.0};
+    };
+
+    PipelineCache(std::size_t capacity);
+
+    // removes and returns the pipeline built for the config, if there is one
+    std::optional<PipelineBuilder::Result> take(const PipelineConfig &config);
+    // stores the pipeline as the most recently used one, evicting the least recently used ones
+    void store(PipelineBuilder::Result pipeline);
+    void clear();
+
+    Stats getStats() const;
+
+  private:
+    std::size_t m_capacity;
+    // most recently used first
+    std::list<PipelineBuilder::Result> m_entries;
+    Stats m_stats;
+
+    static bool matches(const PipelineConfig &a, const PipelineConfig &b);
+};
@@ -0,0 +1,58 @@
+#include "glad/glad.h"
+
+#include "PrimitiveCounter.hpp"
+
+PrimitiveCounter::PrimitiveCounter()
+    : m_queries{}, m_pending{}, m_nextQuery(0), m_created(false)
+{}
+
+void PrimitiveCounter::begin()
+{
+    if (!m_created) {
+        glGenQueries(QUERY_COUNT, m_queries.data());
+        m_created = true;
+    }
+    collectResults();
+
+    // all queries in flight: wait for the oldest one rather than lose it
+    if (m_pending[m_nextQuery]) {
+        GLuint64 count;
+        glGetQueryObjectui64v(m_queries[m_nextQuery], GL_QUERY_RESULT, &count);
+        m_lastCount = count;
+        m_pending[m_nextQuery] = false;
+    }
+
+    glBeginQuery(GL_PRIMITIVES_GENERATED, m_queries[m_nextQuery]);
+}
+
+void PrimitiveCounter::end()
+{
+    glEndQuery(GL_PRIMITIVES_GENERATED);
+    m_pending[m_nextQuery] = true;
+    m_nextQuery = (m_nextQuery + 1) % QUERY_COUNT;
+}
+
+std::optional<std::uint64_t> PrimitiveCounter::getLastCount() const
+{
+    return m_lastCount;
+}
+
+void PrimitiveCounter::collectResults()
+{
+    // from the oldest query, so the last count is the newest available one
+    for (std::size_t i = 0; i < QUERY_COUNT; i++) {
+        std::size_t query = (m_nextQuery + i) % QUERY_COUNT;
+        if (!m_pending[query]) {
+            continue;
+        }
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(m_queries[query], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            break;
+        }
+        GLuint64 count;
+        glGetQueryObjectui64v(m_queries[query], GL_QUERY_RESULT, &count);
+        m_lastCount = count;
+        m_pending[query] = false;
+    }
+}
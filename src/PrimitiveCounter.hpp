@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+/**
+ * Counts the primitives the OpenGL renderer draws between begin() and end().
+ * The results are read a few frames later, once the GPU has them, so counting doesn't stall.
+ * Must be used on the render thread
+ */
+class PrimitiveCounter
+{
+  public:
+    PrimitiveCounter();
+
+    void begin();
+    void end();
+
+    // the count of the latest frame whose result arrived, if any did
+    std::optional<std::uint64_t> getLastCount() const;
+
+  private:
+    // frames in flight before a result is waited for
+    static constexpr std::size_t QUERY_COUNT = 4;
+
+    // the queries are created on first use, when the context is surely current
+    std::array<unsigned int, QUERY_COUNT> m_queries;
+    std::array<bool, QUERY_COUNT> m_pending;
+    std::size_t m_nextQuery;
+    bool m_created;
+    std::optional<std::uint64_t> m_lastCount;
+
+    void collectResults();
+};
@@ -0,0 +1,28 @@
+#include "ProfileNode.hpp"
+
+#include <algorithm>
+
+ProfileNode ProfileNode::fromTree(const MMeter::FuncProfilerTree &tree, std::string name)
+{
+    ProfileNode node;
+    node.name = std::move(name);
+    node.totalDuration = tree.getDuration();
+    node.callCount = tree.getCallCount();
+
+    for (auto &[branchName, branch] : tree.getBranches()) {
+        node.children.push_back(fromTree(branch, branchName));
+    }
+
+    node.selfDuration = std::max(node.totalDuration - node.childrenDuration(),
+                                 std::chrono::duration<double>(0.0));
+    return node;
+}
+
+std::chrono::duration<double> ProfileNode::childrenDuration() const
+{
+    std::chrono::duration<double> sum(0.0);
+    for (auto &child : children) {
+        sum += child.totalDuration;
+    }
+    return sum;
+}
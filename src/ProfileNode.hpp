@@ -0,0 +1,27 @@
+#pragma once
+
+#include "MMeter.h"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Plain copy of one MMeter profiler tree branch, detached from MMeter's internals
+ * so it can be shared with the GUI and exported
+ */
+struct ProfileNode
+{
+    std::string name;
+    std::chrono::duration<double> totalDuration{0.0};
+    // total duration minus the durations of the children
+    std::chrono::duration<double> selfDuration{0.0};
+    std::size_t callCount = 0;
+    std::vector<ProfileNode> children;
+
+    static ProfileNode fromTree(const MMeter::FuncProfilerTree &tree, std::string name);
+
+    // the summed duration of top-level branches; the total of a frame for the render thread
+    std::chrono::duration<double> childrenDuration() const;
+};
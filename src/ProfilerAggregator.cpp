@@ -0,0 +1,144 @@
+#include "ProfilerAggregator.hpp"
+
+#include "Trace.hpp"
+
+#include <utility>
+
+ProfilerAggregator::ProfilerAggregator()
+    : mp_spareTree(std::make_unique<MMeter::FuncProfilerTree>()), m_pendingStale(false),
+      m_threadTreeStale(false), m_resetRequested(false), m_stopRequested(false), m_busy(false),
+      mp_profileTree(std::make_shared<const ProfileNode>())
+{
+    m_thread = std::thread([this]() { threadLoop(); });
+}
+
+ProfilerAggregator::~ProfilerAggregator()
+{
+    {
+        std::unique_lock lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_wakeCondition.notify_one();
+    m_thread.join();
+}
+
+bool ProfilerAggregator::submitThreadTree()
+{
+    std::unique_ptr<MMeter::FuncProfilerTree> p_tree;
+    {
+        std::unique_lock lock(m_mutex);
+        if (mp_pendingTree || !mp_spareTree) {
+            return false;
+        }
+        p_tree = std::move(mp_spareTree);
+    }
+
+    // the spare tree is empty, so after the swap the thread starts measuring from scratch
+    std::swap(*MMeter::getThreadLocalTreePtr(), *p_tree);
+
+    {
+        std::unique_lock lock(m_mutex);
+        mp_pendingTree = std::move(p_tree);
+        // taken after the swap, so a reset during it marks the swapped-out tree
+        m_pendingStale = std::exchange(m_threadTreeStale, false);
+    }
+    m_wakeCondition.notify_one();
+    return true;
+}
+
+void ProfilerAggregator::flush()
+{
+    auto waitUntilIdle = [this]() {
+        std::unique_lock lock(m_mutex);
+        m_idleCondition.wait(lock, [this]() {
+            return !mp_pendingTree && !m_resetRequested && !m_busy && mp_spareTree;
+        });
+    };
+
+    waitUntilIdle();
+    submitThreadTree();
+    waitUntilIdle();
+}
+
+void ProfilerAggregator::reset()
+{
+    {
+        std::unique_lock lock(m_mutex);
+        m_resetRequested = true;
+        m_pendingStale = true;
+        m_threadTreeStale = true;
+    }
+    m_wakeCondition.notify_one();
+}
+
+std::shared_ptr<const ProfileNode> ProfilerAggregator::getProfileTree() const
+{
+    std::unique_lock lock(m_resultMutex);
+    return mp_profileTree;
+}
+
+MMeter::FuncProfilerTree ProfilerAggregator::copyAggregateTree() const
+{
+    std::unique_lock lock(m_mutex);
+    m_idleCondition.wait(lock,
+                         [this]() { return !mp_pendingTree && !m_resetRequested && !m_busy; });
+    return m_aggregateTree;
+}
+
+void ProfilerAggregator::threadLoop()
+{
+    TraceRecorder::instance().setThreadName("Profiler aggregator");
+
+    std::unique_lock lock(m_mutex);
+    while (true) {
+        m_wakeCondition.wait(lock, [this]() {
+            return m_stopRequested || m_resetRequested || mp_pendingTree;
+        });
+        if (m_stopRequested) {
+            break;
+        }
+
+        bool shouldReset = std::exchange(m_resetRequested, false);
+        bool stale = std::exchange(m_pendingStale, false);
+        std::unique_ptr<MMeter::FuncProfilerTree> p_tree = std::move(mp_pendingTree);
+        m_busy = true;
+        lock.unlock();
+
+        if (shouldReset) {
+            m_aggregateTree.reset();
+            auto p_emptyTree = std::make_shared<const ProfileNode>();
+            std::unique_lock resultLock(m_resultMutex);
+            mp_profileTree = std::move(p_emptyTree);
+        }
+        if (p_tree) {
+            // data measured before a reset doesn't belong to the new aggregate
+            if (!stale) {
+                process(*p_tree);
+            }
+            p_tree->reset();
+        }
+
+        lock.lock();
+        if (p_tree) {
+            mp_spareTree = std::move(p_tree);
+        }
+        m_busy = false;
+        m_idleCondition.notify_all();
+    }
+}
+
+void ProfilerAggregator::process(MMeter::FuncProfilerTree &tree)
+{
+    TraceScope traceScope("Profile aggregation");
+
+    m_aggregateTree.merge(tree);
+
+    ProfileNode profileTree = ProfileNode::fromTree(m_aggregateTree, "Total");
+    // the root itself isn't measured
+    profileTree.totalDuration = profileTree.childrenDuration();
+    profileTree.selfDuration = std::chrono::duration<double>(0.0);
+
+    auto p_profileTree = std::make_shared<const ProfileNode>(std::move(profileTree));
+    std::unique_lock resultLock(m_resultMutex);
+    mp_profileTree = std::move(p_profileTree);
+}
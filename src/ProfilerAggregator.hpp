@@ -0,0 +1,73 @@
+#pragma once
+
+#include "ProfileNode.hpp"
+
+#include "MMeter.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * Merges MMeter profiler trees on a background thread.
+ * The measured thread only swaps its thread-local tree with an empty spare one,
+ * all of the merging and conversion happens on the aggregator's own thread
+ */
+class ProfilerAggregator
+{
+  public:
+    ProfilerAggregator();
+    ~ProfilerAggregator();
+
+    /**
+     * Hands the calling thread's MMeter tree over to the aggregator, leaving an empty one behind.
+     * Never blocks on the aggregation; if the previous tree is still being processed
+     * nothing happens and the data is collected the next time.
+     * No MMeter scope may be open on the calling thread, since an open scope would finish
+     * in the swapped-in tree, which lacks its node
+     * @returns whether the tree was handed over
+     */
+    bool submitThreadTree();
+
+    /**
+     * Hands over the calling thread's tree and waits until it's merged
+     */
+    void flush();
+
+    /**
+     * Clears the aggregated data, including any not yet processed tree.
+     * The measured thread's tree can't be cleared from here while its scopes are open,
+     * so the next tree it submits is dropped as well
+     */
+    void reset();
+
+    // the latest aggregate as a plain tree; replaced, never modified
+    std::shared_ptr<const ProfileNode> getProfileTree() const;
+    // waits until the aggregator is idle, since only then the aggregate isn't being modified
+    MMeter::FuncProfilerTree copyAggregateTree() const;
+
+  private:
+    std::thread m_thread;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;
+    mutable std::condition_variable m_idleCondition;
+    std::unique_ptr<MMeter::FuncProfilerTree> mp_pendingTree;
+    std::unique_ptr<MMeter::FuncProfilerTree> mp_spareTree;
+    bool m_pendingStale;
+    // whether the measured thread's tree holds data from before the last reset
+    bool m_threadTreeStale;
+    bool m_resetRequested;
+    bool m_stopRequested;
+    bool m_busy;
+
+    // only modified by the aggregator thread while busy, so merging needs no lock
+    MMeter::FuncProfilerTree m_aggregateTree;
+    // held only to swap the published results, so readers never wait for a merge
+    mutable std::mutex m_resultMutex;
+    std::shared_ptr<const ProfileNode> mp_profileTree;
+
+    void threadLoop();
+    void process(MMeter::FuncProfilerTree &tree);
+};
@@ -0,0 +1,180 @@
+#include "ProfilerTreeModel.h"
+
+#include <algorithm>
+
+ProfilerTreeModel::ProfilerTreeModel(QObject *parent) : QAbstractItemModel(parent) {}
+
+ProfilerTreeModel::~ProfilerTreeModel() {}
+
+void ProfilerTreeModel::update(const ProfileNode &root, const GpuTimes &gpuTimes)
+{
+    syncChildren(m_root, QModelIndex(), root, gpuTimes, root.totalDuration.count() * 1000.0);
+}
+
+void ProfilerTreeModel::syncChildren(Item &item, const QModelIndex &itemIndex,
+                                     const ProfileNode &node, const GpuTimes &gpuTimes,
+                                     double frameMs)
+{
+    // remove branches that disappeared (after a reset)
+    for (int row = (int)item.children.size() - 1; row >= 0; row--) {
+        const std::string &name = item.children[row]->name;
+        if (std::none_of(node.children.begin(), node.children.end(),
+                         [&](const ProfileNode &child) { return child.name == name; })) {
+            beginRemoveRows(itemIndex, row, row);
+            item.children.erase(item.children.begin() + row);
+            for (int i = row; i < (int)item.children.size(); i++) {
+                item.children[i]->row = i;
+            }
+            endRemoveRows();
+        }
+    }
+
+    for (auto &childNode : node.children) {
+        auto it = std::find_if(item.children.begin(), item.children.end(),
+                               [&](const auto &p_child) { return p_child->name == childNode.name; });
+
+        Item *p_child;
+        if (it == item.children.end()) {
+            int row = (int)item.children.size();
+            beginInsertRows(itemIndex, row, row);
+            auto p_newChild = std::make_unique<Item>();
+            p_newChild->name = childNode.name;
+            p_newChild->p_parent = &item;
+            p_newChild->row = row;
+            p_child = p_newChild.get();
+            item.children.push_back(std::move(p_newChild));
+            endInsertRows();
+        } else {
+            p_child = it->get();
+        }
+
+        double selfMs = childNode.selfDuration.count() * 1000.0;
+        double totalMs = childNode.totalDuration.count() * 1000.0;
+        qulonglong callCount = childNode.callCount;
+        double framePercentage = frameMs > 0.0 ? totalMs / frameMs * 100.0 : 0.0;
+        auto gpuIt = gpuTimes.find(childNode.name);
+        double gpuMs = gpuIt != gpuTimes.end() ? gpuIt->second.count() * 1000.0 : -1.0;
+
+        if (p_child->selfMs != selfMs || p_child->totalMs != totalMs || p_child->gpuMs != gpuMs ||
+            p_child->callCount != callCount || p_child->framePercentage != framePercentage) {
+            p_child->selfMs = selfMs;
+            p_child->totalMs = totalMs;
+            p_child->gpuMs = gpuMs;
+            p_child->callCount = callCount;
+            p_child->framePercentage = framePercentage;
+            emit dataChanged(createIndex(p_child->row, SelfColumn, p_child),
+                             createIndex(p_child->row, ColumnCount - 1, p_child));
+        }
+
+        syncChildren(*p_child, createIndex(p_child->row, NameColumn, p_child), childNode,
+                     gpuTimes, frameMs);
+    }
+}
+
+QModelIndex ProfilerTreeModel::index(int row, int column, const QModelIndex &parent) const
+{
+    Item *p_parent = itemFor(parent);
+    if (row < 0 || row >= (int)p_parent->children.size() || column < 0 ||
+        column >= ColumnCount) {
+        return QModelIndex();
+    }
+    return createIndex(row, column, p_parent->children[row].get());
+}
+
+QModelIndex ProfilerTreeModel::parent(const QModelIndex &index) const
+{
+    if (!index.isValid()) {
+        return QModelIndex();
+    }
+    Item *p_parent = itemFor(index)->p_parent;
+    if (p_parent == &m_root) {
+        return QModelIndex();
+    }
+    return createIndex(p_parent->row, NameColumn, p_parent);
+}
+
+int ProfilerTreeModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid() && parent.column() != NameColumn) {
+        return 0;
+    }
+    return (int)itemFor(parent)->children.size();
+}
+
+int ProfilerTreeModel::columnCount(const QModelIndex &parent) const
+{
+    return ColumnCount;
+}
+
+QVariant ProfilerTreeModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid()) {
+        return QVariant();
+    }
+    const Item &item = *itemFor(index);
+
+    if (role == Qt::DisplayRole) {
+        switch (index.column()) {
+        case NameColumn:
+            return QString::fromStdString(item.name);
+        case SelfColumn:
+            return QString::number(item.selfMs, 'f', 3) + " ms";
+        case TotalColumn:
+            return QString::number(item.totalMs, 'f', 3) + " ms";
+        case GpuColumn:
+            return item.gpuMs >= 0.0 ? QString::number(item.gpuMs, 'f', 3) + " ms" : QString();
+        case CallsColumn:
+            return item.callCount;
+        case FramePercentageColumn:
+            return QString::number(item.framePercentage, 'f', 2) + " %";
+        }
+    } else if (role == SortRole) {
+        switch (index.column()) {
+        case NameColumn:
+            return QString::fromStdString(item.name);
+        case SelfColumn:
+            return item.selfMs;
+        case TotalColumn:
+            return item.totalMs;
+        case GpuColumn:
+            return item.gpuMs;
+        case CallsColumn:
+            return item.callCount;
+        case FramePercentageColumn:
+            return item.framePercentage;
+        }
+    } else if (role == Qt::TextAlignmentRole && index.column() != NameColumn) {
+        return int(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    return QVariant();
+}
+
+QVariant ProfilerTreeModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    switch (section) {
+    case NameColumn:
+        return "Scope";
+    case SelfColumn:
+        return "Self time";
+    case TotalColumn:
+        return "Total time";
+    case GpuColumn:
+        return "GPU time";
+    case CallsColumn:
+        return "Calls";
+    case FramePercentageColumn:
+        return "% of frame";
+    }
+    return QVariant();
+}
+
+ProfilerTreeModel::Item *ProfilerTreeModel::itemFor(const QModelIndex &index) const
+{
+    if (!index.isValid()) {
+        return const_cast<Item *>(&m_root);
+    }
+    return static_cast<Item *>(index.internalPointer());
+}
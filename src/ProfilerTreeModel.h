@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QtCore/QAbstractItemModel>
+
+#include "GpuProfiler.hpp"
+#include "ProfileNode.hpp"
+
+#include <memory>
+#include <vector>
+
+/**
+ * Item model over the aggregated profiler tree.
+ * New trees are merged into the existing items by branch name,
+ * so only changed rows are signaled and the view keeps its expansion and selection
+ */
+class ProfilerTreeModel : public QAbstractItemModel
+{
+  public:
+    enum Column
+    {
+        NameColumn,
+        SelfColumn,
+        TotalColumn,
+        GpuColumn,
+        CallsColumn,
+        FramePercentageColumn,
+        ColumnCount
+    };
+
+    // data role with raw numeric values, for sorting
+    static constexpr int SortRole = Qt::UserRole;
+
+    ProfilerTreeModel(QObject *parent = nullptr);
+    virtual ~ProfilerTreeModel();
+
+    // GPU times are shown for the scopes of the same name
+    void update(const ProfileNode &root, const GpuTimes &gpuTimes);
+
+    QModelIndex index(int row, int column, const QModelIndex &parent) const override;
+    QModelIndex parent(const QModelIndex &index) const override;
+    int rowCount(const QModelIndex &parent) const override;
+    int columnCount(const QModelIndex &parent) const override;
+    QVariant data(const QModelIndex &index, int role) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+
+  private:
+    struct Item
+    {
+        std::string name;
+        double selfMs = 0.0;
+        double totalMs = 0.0;
+        // negative if not measured on the GPU
+        double gpuMs = -1.0;
+        qulonglong callCount = 0;
+        double framePercentage = 0.0;
+
+        Item *p_parent = nullptr;
+        int row = 0;
+        std::vector<std::unique_ptr<Item>> children;
+    };
+
+    Item m_root;
+
+    Item *itemFor(const QModelIndex &index) const;
+    void syncChildren(Item &item, const QModelIndex &itemIndex, const ProfileNode &node,
+                      const GpuTimes &gpuTimes, double frameMs);
+};
@@ -1,27 +1,51 @@
 #include "ProfilerWindow.h"
 
-#include <QtWidgets/QColorDialog>
-#include <QtWidgets/QComboBox>
-#include <QtWidgets/QDoubleSpinBox>
-#include <QtWidgets/QPushButton>
-#include <QtWidgets/QScrollBar>
-
-#include <mutex>
+#include <QtWidgets/QHeaderView>
 
 ProfilerWindow::ProfilerWindow(AssetCollection &assetCollection, Status &status)
     : QMainWindow(), ui(), m_assetCollection(assetCollection), m_status(status)
 {
     ui.setupUi(this);
 
-    updateValues();
+    m_sortedTreeModel.setSourceModel(&m_treeModel);
+    m_sortedTreeModel.setSortRole(ProfilerTreeModel::SortRole);
+    m_sortedTreeModel.setDynamicSortFilter(true);
+    ui.profilerTree->setModel(&m_sortedTreeModel);
+    ui.profilerTree->sortByColumn(ProfilerTreeModel::TotalColumn, Qt::DescendingOrder);
+    ui.profilerTree->header()->setSectionResizeMode(ProfilerTreeModel::NameColumn,
+                                                    QHeaderView::Stretch);
+    ui.profilerTree->header()->setStretchLastSection(false);
 }
 
 ProfilerWindow::~ProfilerWindow() {}
 
-void ProfilerWindow::updateValues()
+void ProfilerWindow::updateValues(const FrameSnapshot &snapshot)
 {
-    int pos = ui.profilerMetrics->verticalScrollBar()->value();
-    ui.profilerMetrics->setText(QString::fromStdString(m_status.mmeterMetrics));
-    ui.profilerMetrics->setMaximumHeight(5000000);
-    ui.profilerMetrics->verticalScrollBar()->setValue(pos);
+    const PipelineCache::Stats &cacheStats = snapshot.pipelineCacheStats;
+    QString cacheStatsText =
+        "Pipeline cache: " + QString::number(cacheStats.entryCount) + "/" +
+        QString::number(cacheStats.capacity) + " pipelines, " +
+        QString::number(cacheStats.hitCount) + " hits, " +
+        QString::number(cacheStats.missCount) + " misses, " +
+        QString::number(cacheStats.evictionCount) + " evictions, " +
+        QString::number(cacheStats.savedBuildDuration.count(), 'f', 2) + "s of builds saved";
+    if (cacheStatsText != m_shownCacheStats) {
+        m_shownCacheStats = cacheStatsText;
+        ui.statusbar->showMessage(cacheStatsText);
+    }
+
+    // only update when a new aggregate was published
+    if (!snapshot.p_profileTree || !snapshot.p_gpuTimes ||
+        (snapshot.p_profileTree == mp_shownTree && snapshot.p_gpuTimes == mp_shownGpuTimes)) {
+        return;
+    }
+    bool firstTree = !mp_shownTree || mp_shownTree->children.empty();
+    mp_shownTree = snapshot.p_profileTree;
+    mp_shownGpuTimes = snapshot.p_gpuTimes;
+
+    m_treeModel.update(*mp_shownTree, *mp_shownGpuTimes);
+
+    if (firstTree) {
+        ui.profilerTree->expandToDepth(1);
+    }
 }
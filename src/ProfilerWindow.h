@@ -2,8 +2,11 @@
 
 #include "ui_Profiler.h"
 
+#include <QtCore/QSortFilterProxyModel>
 #include <QtWidgets/QMainWindow>
 
+#include "ProfilerTreeModel.h"
+#include "Snapshot.hpp"
 #include "Status.hpp"
 #include "assetCollection.hpp"
 
@@ -13,11 +16,17 @@ class ProfilerWindow : public QMainWindow
     ProfilerWindow(AssetCollection &assetCollection, Status &status);
     virtual ~ProfilerWindow();
 
-    void updateValues();
+    void updateValues(const FrameSnapshot &snapshot);
 
   private:
     Ui::Profiler ui;
 
     AssetCollection &m_assetCollection;
     Status &m_status;
-};
\ No newline at end of file
+
+    ProfilerTreeModel m_treeModel;
+    QSortFilterProxyModel m_sortedTreeModel;
+    std::shared_ptr<const ProfileNode> mp_shownTree;
+    std::shared_ptr<const GpuTimes> mp_shownGpuTimes;
+    QString m_shownCacheStats;
+};
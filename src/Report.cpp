@@ -0,0 +1,219 @@
+#include "Report.hpp"
+
+#include "JsonWriter.hpp"
+
+namespace
+{
+void writePercentiles(JsonWriter &json, const FrameTimeHistogram &histogram)
+{
+    FrameTimePercentiles percentiles(histogram);
+
+    json.beginObject();
+    json.field("count", (std::uint64_t)histogram.count());
+    json.field("meanMs", histogram.mean().count() * 1000.0);
+    json.field("minMs", histogram.min().count() * 1000.0);
+    json.field("p50Ms", percentiles.p50.count() * 1000.0);
+    json.field("p90Ms", percentiles.p90.count() * 1000.0);
+    json.field("p99Ms", percentiles.p99.count() * 1000.0);
+    json.field("p999Ms", percentiles.p999.count() * 1000.0);
+    json.field("maxMs", percentiles.max.count() * 1000.0);
+    json.endObject();
+}
+
+void writeProfileNode(JsonWriter &json, const ProfileNode &node)
+{
+    json.beginObject();
+    json.field("name", node.name);
+    json.field("totalMs", node.totalDuration.count() * 1000.0);
+    json.field("selfMs", node.selfDuration.count() * 1000.0);
+    json.field("calls", (std::uint64_t)node.callCount);
+    json.key("children");
+    json.beginArray();
+    for (auto &child : node.children) {
+        writeProfileNode(json, child);
+    }
+    json.endArray();
+    json.endObject();
+}
+} // namespace
+
+void Report::writeJson(std::ostream &out) const
+{
+    JsonWriter json(out);
+
+    json.beginObject();
+
+    json.key("options");
+    json.beginObject();
+    json.field("scene", options.scenePath.string());
+    json.field("sceneScale", (double)options.sceneScale);
+    json.field("propCount", (std::uint64_t)propCount);
+    json.field("amplificationCopies", (std::uint64_t)options.amplification.copyCount());
+    json.field("warmupFrames", (std::uint64_t)options.warmupFrames);
+    json.field("measuredFrames", (std::uint64_t)options.measuredFrames);
+    json.field("frameWidth", (std::uint64_t)options.frameWidth);
+    json.field("frameHeight", (std::uint64_t)options.frameHeight);
+    json.endObject();
+
+    json.key("startup");
+    json.beginObject();
+    json.field("totalMs", status.startupTimes.total().count() * 1000.0);
+    json.key("stages");
+    json.beginArray();
+    for (auto &stage : status.startupTimes.stages) {
+        json.beginObject();
+        json.field("name", stage.name);
+        json.field("ms", stage.duration.count() * 1000.0);
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+
+    json.key("frames");
+    json.beginObject();
+    json.field("count", (std::uint64_t)status.pipelineFrameCount);
+    json.field("totalSeconds", status.pipelineSumFrameDuration.count());
+    json.field("avgMs", status.pipelineAvgFrameDuration.count() * 1000.0);
+    json.field("fps", (double)status.pipelineFPS);
+    json.field("warmupFrames", (std::uint64_t)status.pipelineWarmupFrameCount);
+    json.field("warmupMs", status.pipelineWarmupDuration.count() * 1000.0);
+    json.field("pipelineBuildMs", status.pipelineBuildDuration.count() * 1000.0);
+    json.key("pipeline");
+    writePercentiles(json, status.pipelineHistogram);
+    json.key("total");
+    writePercentiles(json, status.totalHistogram);
+    json.endObject();
+
+    if (p_framePacer) {
+        // of the measured frames; the intervals include the waits, unlike the frame times
+        FramePacer::Stats stats = p_framePacer->getStats();
+        json.key("pacing");
+        json.beginObject();
+        json.field("mode", FramePacer::modeName(p_framePacer->getMode()));
+        if (p_framePacer->getMode() == FramePacer::Mode::FixedRate) {
+            json.field("targetRate", p_framePacer->getTargetRate());
+        }
+        json.field("frames", (std::uint64_t)stats.frameCount);
+        json.field("avgIntervalMs", stats.avgInterval.count() * 1000.0);
+        json.field("jitterMs", stats.intervalJitter.count() * 1000.0);
+        json.field("busyMs", stats.busyDuration.count() * 1000.0);
+        json.field("idleMs", stats.idleDuration.count() * 1000.0);
+        json.field("idleFraction", stats.idleFraction());
+        json.key("intervals");
+        writePercentiles(json, p_framePacer->getIntervalHistogram());
+        json.endObject();
+    }
+
+    if (p_inputLatencyTracker) {
+        // compose ends after the present is issued, present when the GPU finished the frame
+        InputLatencyTracker::Stats stats = p_inputLatencyTracker->getStats();
+        json.key("inputLatency");
+        json.beginObject();
+        json.field("inputs", (std::uint64_t)stats.inputCount);
+        json.field("presented", (std::uint64_t)stats.presentedCount);
+        json.field("avgFrameDelay", stats.avgFrameDelay);
+        json.field("maxFrameDelay", (std::uint64_t)stats.maxFrameDelay);
+        json.key("toCompose");
+        writePercentiles(json, p_inputLatencyTracker->getComposeHistogram());
+        json.key("toPresent");
+        writePercentiles(json, p_inputLatencyTracker->getPresentHistogram());
+        json.endObject();
+    }
+
+    if (p_comparisonViews && !p_comparisonViews->empty() && p_composeHistogram) {
+        // CPU time of the composes in the same frames
+        json.key("comparison");
+        json.beginArray();
+        json.beginObject();
+        json.field("name", "main");
+        json.field("built", true);
+        json.key("compose");
+        writePercentiles(json, *p_composeHistogram);
+        json.endObject();
+        for (auto &view : *p_comparisonViews) {
+            json.beginObject();
+            json.field("name", view.name);
+            json.field("built", view.p_comp != nullptr);
+            json.field("buildMs", view.buildDuration.count() * 1000.0);
+            json.key("compose");
+            writePercentiles(json, view.composeHistogram);
+            json.endObject();
+        }
+        json.endArray();
+    }
+
+    if (p_cameraPath) {
+        json.key("cameraPathSegments");
+        json.beginArray();
+        for (auto &stats : p_cameraPath->getSegmentStats()) {
+            json.beginObject();
+            json.field("frames", (std::uint64_t)stats.frameCount);
+            json.field("avgMs", stats.frameCount ? stats.sumFrameDuration.count() * 1000.0 /
+                                                       stats.frameCount
+                                                 : 0.0);
+            json.field("maxMs", stats.maxFrameDuration.count() * 1000.0);
+            json.endObject();
+        }
+        json.endArray();
+    }
+
+    if (p_memoryBudget) {
+        MemoryBudget::Stats stats = p_memoryBudget->getStats();
+        json.key("memory");
+        json.beginObject();
+        json.field("budgetBytes", (std::uint64_t)stats.budgetBytes);
+        json.field("residentBytes", (std::uint64_t)stats.residentBytes);
+        json.field("evictions", (std::uint64_t)stats.evictionCount);
+        json.field("evictedBytes", (std::uint64_t)stats.evictedBytes);
+        json.endObject();
+    }
+
+    if (p_frustumCuller) {
+        // of the last frame; the cull time per frame is in the profiler tree
+        FrustumCuller::Stats stats = p_frustumCuller->getStats();
+        json.key("culling");
+        json.beginObject();
+        json.field("props", (std::uint64_t)stats.propCount);
+        json.field("visible", (std::uint64_t)stats.visibleCount);
+        json.field("tests", (std::uint64_t)stats.testCount);
+        json.endObject();
+    }
+
+    if (p_occlusionCuller) {
+        // of the last frame, like the culling
+        OcclusionCuller::Stats stats = p_occlusionCuller->getStats();
+        json.key("occlusion");
+        json.beginObject();
+        json.field("occluders", (std::uint64_t)stats.occluderCount);
+        json.field("tested", (std::uint64_t)stats.testedCount);
+        json.field("occluded", (std::uint64_t)stats.occludedCount);
+        json.field("rasterizeMs", stats.rasterizeDuration.count() * 1000.0);
+        json.field("testMs", stats.testDuration.count() * 1000.0);
+        json.endObject();
+    }
+
+    json.key("profiler");
+    json.beginObject();
+    json.key("tree");
+    writeProfileNode(json, *status.profiler.getProfileTree());
+    json.field("flat", status.profiler.copyAggregateTree().totalsByDurationStr());
+    if (p_gpuTimes) {
+        // of the measured frames, like the tree
+        json.key("gpu");
+        json.beginArray();
+        for (auto &[name, duration] : *p_gpuTimes) {
+            json.beginObject();
+            json.field("name", name);
+            json.field("totalMs", duration.count() * 1000.0);
+            json.field("avgMs", status.pipelineFrameCount
+                                    ? duration.count() * 1000.0 / status.pipelineFrameCount
+                                    : 0.0);
+            json.endObject();
+        }
+        json.endArray();
+    }
+    json.endObject();
+
+    json.endObject();
+    out << std::endl;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <ostream>
+
+#include "CameraPath.hpp"
+#include "ComparisonView.hpp"
+#include "FramePacer.hpp"
+#include "FrustumCuller.hpp"
+#include "GpuProfiler.hpp"
+#include "InputLatencyTracker.hpp"
+#include "MemoryBudget.hpp"
+#include "OcclusionCuller.hpp"
+#include "Options.hpp"
+#include "Status.hpp"
+
+/**
+ * Machine-readable summary of a run, written as JSON
+ */
+struct Report
+{
+    const Options &options;
+    const Status &status;
+    const CameraPathPlayer *p_cameraPath = nullptr;
+    const MemoryBudget *p_memoryBudget = nullptr;
+    const FrustumCuller *p_frustumCuller = nullptr;
+    const OcclusionCuller *p_occlusionCuller = nullptr;
+    const GpuTimes *p_gpuTimes = nullptr;
+    const FramePacer *p_framePacer = nullptr;
+    const InputLatencyTracker *p_inputLatencyTracker = nullptr;
+    // compared with the main pipeline's compose histogram
+    const std::vector<ComparisonView> *p_comparisonViews = nullptr;
+    const FrameTimeHistogram *p_composeHistogram = nullptr;
+    // after the amplification
+    std::size_t propCount = 0;
+
+    void writeJson(std::ostream &out) const;
+};
@@ -0,0 +1,44 @@
+#include "ResolutionController.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+ResolutionController::ResolutionController(std::chrono::duration<double> targetFrameDuration,
+                                           float minScale, float maxScale)
+    : m_target(targetFrameDuration), m_minScale(minScale), m_maxScale(maxScale),
+      m_scale(maxScale), m_sampleCount(0)
+{}
+
+bool ResolutionController::update(const Status &status)
+{
+    if (status.currentTimeStamp != m_lastSampleTime) {
+        m_lastSampleTime = status.currentTimeStamp;
+        m_sampleCount++;
+    }
+
+    auto ratio = m_target.update(status);
+    if (!ratio) {
+        return false;
+    }
+
+    // the pixel count is the square of the scale
+    float scale = m_scale / (float)std::sqrt(*ratio);
+    scale = std::round(scale / SCALE_QUANTUM) * SCALE_QUANTUM;
+    scale = std::clamp(scale, m_minScale, m_maxScale);
+    if (scale == m_scale) {
+        return false;
+    }
+    m_scale = scale;
+    m_target.settle();
+    return true;
+}
+
+float ResolutionController::getScale() const
+{
+    return m_scale;
+}
+
+std::size_t ResolutionController::getSampleCount() const
+{
+    return m_sampleCount;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "FrameTimeTarget.hpp"
+#include "Status.hpp"
+
+#include <chrono>
+#include <cstddef>
+
+/**
+ * Scales the render resolution to keep the average frame duration near a target,
+ * assuming the cost of a frame is proportional to its pixel count
+ */
+class ResolutionController
+{
+  public:
+    // scales are rounded to this, so small deviations don't reallocate the frame
+    static constexpr float SCALE_QUANTUM = 0.05f;
+
+    ResolutionController(std::chrono::duration<double> targetFrameDuration, float minScale,
+                         float maxScale);
+
+    // to be called after each Status update; @returns whether the scale changed
+    bool update(const Status &status);
+
+    // of each dimension of the display frame
+    float getScale() const;
+    // increments with each average considered, for plotting the scale over time
+    std::size_t getSampleCount() const;
+
+  private:
+    FrameTimeTarget m_target;
+    float m_minScale;
+    float m_maxScale;
+    float m_scale;
+    std::size_t m_sampleCount;
+    std::chrono::steady_clock::time_point m_lastSampleTime;
+};
@@ -0,0 +1,99 @@
+#include "SceneAmplifier.hpp"
+
+#include "Bounds.hpp"
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+// used if the scene has no extent to derive the spacing from, e.g. no props
+constexpr float FALLBACK_SPACING = 10.0f;
+// gap between neighbouring copies, relative to the scene size
+constexpr float SPACING_MARGIN = 1.1f;
+
+float deriveSpacing(const Scene &scene)
+{
+    // from the meshes rather than the prop origins, which are often all at the scene origin
+    Bounds sceneBounds;
+    for (auto &prop : scene.modelProps) {
+        sceneBounds.merge(propBounds(prop));
+    }
+    if (sceneBounds.isEmpty()) {
+        return FALLBACK_SPACING;
+    }
+    glm::vec3 size = sceneBounds.extent() * 2.0f;
+    float largestSize = std::max({size.x, size.y, size.z});
+
+    return largestSize > 0.0f ? largestSize * SPACING_MARGIN : FALLBACK_SPACING;
+}
+
+std::vector<glm::vec3> copyOffsets(const Amplification &amplification, float spacing)
+{
+    std::mt19937_64 random(amplification.seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<glm::vec3> offsets;
+    offsets.reserve(amplification.copyCount());
+
+    if (amplification.layout == Amplification::Layout::Grid) {
+        auto &size = amplification.gridSize;
+        for (std::size_t x = 0; x < size[0]; x++) {
+            for (std::size_t y = 0; y < size[1]; y++) {
+                for (std::size_t z = 0; z < size[2]; z++) {
+                    offsets.push_back(glm::vec3(x, y, z) * spacing);
+                }
+            }
+        }
+    } else if (amplification.layout == Amplification::Layout::Scatter) {
+        // keeps the density of a square grid with the same number of copies
+        float side = spacing * std::sqrt((float)amplification.scatterCount);
+        for (std::size_t i = 0; i < amplification.scatterCount; i++) {
+            // drawn in a fixed order, as the order of evaluating arguments is unspecified
+            float x = unit(random);
+            float z = unit(random);
+            offsets.push_back(glm::vec3(x, 0.0f, z) * side);
+        }
+    } else {
+        offsets.push_back(glm::vec3(0.0f));
+    }
+
+    if (amplification.jitter > 0.0) {
+        float maxJitter = (float)amplification.jitter * spacing;
+        for (auto &offset : offsets) {
+            float x = unit(random);
+            float y = unit(random);
+            float z = unit(random);
+            offset += (glm::vec3(x, y, z) * 2.0f - 1.0f) * maxJitter;
+        }
+    }
+
+    return offsets;
+}
+} // namespace
+
+void amplifyScene(Scene &scene, const Amplification &amplification)
+{
+    PROFILE_SCOPE("Scene amplification");
+
+    float spacing =
+        amplification.spacing > 0.0 ? (float)amplification.spacing : deriveSpacing(scene);
+    std::vector<glm::vec3> offsets = copyOffsets(amplification, spacing);
+
+    auto &props = scene.modelProps;
+    std::size_t originalCount = props.size();
+    props.reserve(originalCount * offsets.size());
+
+    // the first copy reuses the original props
+    for (std::size_t copy = 1; copy < offsets.size(); copy++) {
+        for (std::size_t i = 0; i < originalCount; i++) {
+            auto &prop = props.emplace_back(props[i]);
+            prop.transform.position += offsets[copy] - offsets[0];
+        }
+    }
+    for (std::size_t i = 0; i < originalCount; i++) {
+        props[i].transform.position += offsets[0];
+    }
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Options.hpp"
+
+#include "Vitrae/Assets/Scene.hpp"
+
+using namespace Vitrae;
+
+/**
+ * Replaces the props of the scene with copies of them laid out as specified.
+ * Each copy of the scene is offset as a whole, so the props keep their arrangement
+ */
+void amplifyScene(Scene &scene, const Amplification &amplification);
@@ -0,0 +1,206 @@
+#include "SceneCache.hpp"
+
+#include "assimp/DefaultIOSystem.h"
+#include "assimp/Exporter.hpp"
+#include "assimp/Importer.hpp"
+#include "assimp/scene.h"
+
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace
+{
+// bump when the baked content or the sidecar format changes, to invalidate old caches
+constexpr const char *CACHE_HEADER = "VitraeShowcase baked scene v3";
+constexpr std::size_t HASH_CHUNK_SIZE = 1 << 20;
+
+constexpr std::uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+
+// 64-bit FNV-1a
+void hashBytes(std::uint64_t &hash, const void *p_data, std::size_t size)
+{
+    auto p_bytes = static_cast<const unsigned char *>(p_data);
+    for (std::size_t i = 0; i < size; i++) {
+        hash ^= p_bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+}
+
+/**
+ * Assimp's file access, recording every file the import opens.
+ * The paths are kept relative to the scene's directory, so the sidecar survives moving both
+ */
+class RecordingIOSystem : public Assimp::DefaultIOSystem
+{
+  public:
+    RecordingIOSystem(const std::filesystem::path &directory) : m_directory(directory) {}
+
+    Assimp::IOStream *Open(const char *pFile, const char *pMode = "rb") override
+    {
+        Assimp::IOStream *p_stream = DefaultIOSystem::Open(pFile, pMode);
+        // files that failed to open aren't dependencies, or hashing them would always fail
+        if (p_stream) {
+            std::error_code ec;
+            std::filesystem::path filepath = std::filesystem::absolute(pFile, ec);
+            if (!ec) {
+                m_openedFiles.insert(
+                    filepath.lexically_normal().lexically_relative(m_directory).generic_string());
+            }
+        }
+        return p_stream;
+    }
+
+    // sorted, so the hash doesn't depend on the order the importer opened them
+    const std::set<std::string> &getOpenedFiles() const { return m_openedFiles; }
+
+  private:
+    std::filesystem::path m_directory;
+    std::set<std::string> m_openedFiles;
+};
+
+std::optional<std::uint64_t> hashFile(const std::filesystem::path &filepath)
+{
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+
+    std::uint64_t hash = FNV_OFFSET_BASIS;
+    std::vector<char> buffer(HASH_CHUNK_SIZE);
+    while (file) {
+        file.read(buffer.data(), buffer.size());
+        hashBytes(hash, buffer.data(), (std::size_t)file.gcount());
+    }
+    if (file.bad()) {
+        return std::nullopt;
+    }
+    return hash;
+}
+
+/**
+ * Hashes the content of the scene file, and the sizes and modification times of the dependencies;
+ * reading them all would take as long as the import, so only their metadata is hashed
+ * @returns the hash, or nothing if any of the files can't be read
+ */
+std::optional<std::uint64_t> hashSource(const std::filesystem::path &scenePath,
+                                        const std::filesystem::path &directory,
+                                        const std::set<std::string> &dependencies)
+{
+    std::optional<std::uint64_t> hash = hashFile(scenePath);
+    if (!hash) {
+        return std::nullopt;
+    }
+
+    for (auto &relativePath : dependencies) {
+        std::filesystem::path filepath = directory / relativePath;
+        std::error_code ec;
+        std::uint64_t size = std::filesystem::file_size(filepath, ec);
+        if (ec) {
+            return std::nullopt;
+        }
+        auto modifiedTime = std::filesystem::last_write_time(filepath, ec);
+        if (ec) {
+            return std::nullopt;
+        }
+        hashBytes(*hash, relativePath.data(), relativePath.size());
+        hashBytes(*hash, &size, sizeof(size));
+        auto modifiedTicks = modifiedTime.time_since_epoch().count();
+        hashBytes(*hash, &modifiedTicks, sizeof(modifiedTicks));
+    }
+    return hash;
+}
+
+std::filesystem::path sceneDirectory(const std::filesystem::path &scenePath)
+{
+    std::error_code ec;
+    std::filesystem::path absolutePath = std::filesystem::absolute(scenePath, ec);
+    return (ec ? scenePath : absolutePath).lexically_normal().parent_path();
+}
+} // namespace
+
+namespace SceneCache
+{
+std::filesystem::path bakedPath(const std::filesystem::path &scenePath)
+{
+    return std::filesystem::path(scenePath).concat(".baked.assbin");
+}
+
+std::filesystem::path hashPath(const std::filesystem::path &scenePath)
+{
+    return std::filesystem::path(scenePath).concat(".baked.hash");
+}
+
+bool isUpToDate(const std::filesystem::path &scenePath)
+{
+    std::error_code ec;
+    if (!std::filesystem::exists(bakedPath(scenePath), ec)) {
+        return false;
+    }
+
+    // sidecar: header, hash, then one dependency path per line
+    std::ifstream file(hashPath(scenePath));
+    std::string header;
+    std::uint64_t bakedHash;
+    if (!std::getline(file, header) || header != CACHE_HEADER || !(file >> std::hex >> bakedHash)) {
+        return false;
+    }
+    file >> std::ws;
+    std::set<std::string> dependencies;
+    for (std::string line; std::getline(file, line);) {
+        if (!line.empty()) {
+            dependencies.insert(line);
+        }
+    }
+
+    std::optional<std::uint64_t> sourceHash =
+        hashSource(scenePath, sceneDirectory(scenePath), dependencies);
+    return sourceHash && *sourceHash == bakedHash;
+}
+
+void bake(const std::filesystem::path &scenePath)
+{
+    std::filesystem::path directory = sceneDirectory(scenePath);
+
+    // no post-processing; the engine's loader does it on the baked copy as on the source
+    Assimp::Importer importer;
+    auto p_ioSystem = new RecordingIOSystem(directory);
+    importer.SetIOHandler(p_ioSystem); // owned by the importer from here on
+    const aiScene *p_scene = importer.ReadFile(scenePath.string(), 0);
+    if (!p_scene) {
+        throw std::runtime_error("Cannot import " + scenePath.string() + ": " +
+                                 importer.GetErrorString());
+    }
+
+    // the scene file itself is hashed by content
+    std::set<std::string> dependencies = p_ioSystem->getOpenedFiles();
+    dependencies.erase(scenePath.filename().generic_string());
+    std::optional<std::uint64_t> sourceHash = hashSource(scenePath, directory, dependencies);
+    if (!sourceHash) {
+        throw std::runtime_error("Cannot hash " + scenePath.string());
+    }
+
+    // written under a temporary name so an interrupted bake never looks complete
+    std::filesystem::path tempPath = std::filesystem::path(bakedPath(scenePath)).concat(".tmp");
+    Assimp::Exporter exporter;
+    if (exporter.Export(p_scene, "assbin", tempPath.string()) != AI_SUCCESS) {
+        throw std::runtime_error("Cannot bake " + scenePath.string() + ": " +
+                                 exporter.GetErrorString());
+    }
+    std::filesystem::rename(tempPath, bakedPath(scenePath));
+
+    std::ofstream file(hashPath(scenePath));
+    file << CACHE_HEADER << std::endl << std::hex << *sourceHash << std::endl;
+    for (auto &dependency : dependencies) {
+        file << dependency << std::endl;
+    }
+    if (!file) {
+        throw std::runtime_error("Cannot write " + hashPath(scenePath).string());
+    }
+}
+} // namespace SceneCache
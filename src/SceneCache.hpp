@@ -0,0 +1,26 @@
+#pragma once
+
+#include <filesystem>
+
+/**
+ * Baked copies of scene files, stored next to them in Assimp's binary format.
+ * A baked copy is used only while the files it was baked from are unchanged
+ */
+namespace SceneCache
+{
+std::filesystem::path bakedPath(const std::filesystem::path &scenePath);
+std::filesystem::path hashPath(const std::filesystem::path &scenePath);
+
+/**
+ * Checks the content of the scene file, and the sizes and modification times of the other files
+ * the import opened (such as .mtl for OBJ or .bin for glTF), against the hash sidecar
+ * @returns whether the baked copy exists and all of them are unchanged; false on any error
+ */
+bool isUpToDate(const std::filesystem::path &scenePath);
+
+/**
+ * Imports the scene and writes its baked copy, with a hash sidecar listing the files it opened
+ * @throws std::runtime_error if the scene can't be imported, hashed or written
+ */
+void bake(const std::filesystem::path &scenePath);
+} // namespace SceneCache
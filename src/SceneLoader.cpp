@@ -0,0 +1,113 @@
+#include "SceneLoader.hpp"
+
+#include "ParallelFor.hpp"
+#include "SceneAmplifier.hpp"
+#include "SceneCache.hpp"
+#include "Trace.hpp"
+
+#include "dynasma/standalone.hpp"
+
+#include <iostream>
+
+dynasma::FirmPtr<Scene> SceneLoader::load(ComponentRoot &root,
+                                          const std::filesystem::path &filepath, float scale,
+                                          CacheMode cacheMode,
+                                          const Amplification &amplification)
+{
+    PROFILE_SCOPE("Scene loading");
+
+    StartupTimes times;
+    {
+        std::unique_lock lock(m_mutex);
+        m_progress.startTime = std::chrono::steady_clock::now();
+    }
+
+    dynasma::FirmPtr<Scene> p_scene;
+    try {
+        std::filesystem::path loadedPath = resolveCache(filepath, cacheMode, times);
+
+        setState(State::Parsing, times);
+        p_scene = dynasma::makeStandalone<Scene>(
+            Scene::FileLoadParams{.root = root, .filepath = loadedPath});
+    }
+    catch (const std::exception &e) {
+        std::unique_lock lock(m_mutex);
+        m_progress.state = State::Failed;
+        m_progress.error = e.what();
+        throw;
+    }
+    times.mark("Parsing");
+
+    {
+        std::unique_lock lock(m_mutex);
+        m_progress.propCount = p_scene->modelProps.size();
+    }
+    setState(State::Scaling, times);
+
+    // in case of wrong scale
+    auto &props = p_scene->modelProps;
+    parallelFor(props.size(), [&](std::size_t i) {
+        props[i].transform.position = props[i].transform.position * scale;
+        props[i].transform.scale(glm::vec3(scale));
+    });
+    times.mark("Scaling");
+
+    if (amplification.layout != Amplification::Layout::None) {
+        setState(State::Amplifying, times);
+        amplifyScene(*p_scene, amplification);
+        times.mark("Amplifying");
+
+        std::unique_lock lock(m_mutex);
+        m_progress.propCount = p_scene->modelProps.size();
+    }
+
+    setState(State::Done, times);
+
+    return p_scene;
+}
+
+SceneLoader::Progress SceneLoader::getProgress() const
+{
+    std::unique_lock lock(m_mutex);
+    return m_progress;
+}
+
+void SceneLoader::setState(State state, const StartupTimes &times)
+{
+    std::unique_lock lock(m_mutex);
+    m_progress.state = state;
+    m_progress.stages = times.stages;
+}
+
+std::filesystem::path SceneLoader::resolveCache(const std::filesystem::path &filepath,
+                                                CacheMode cacheMode, StartupTimes &times)
+{
+    if (cacheMode == CacheMode::Ignore ||
+        (cacheMode == CacheMode::Use && !std::filesystem::exists(SceneCache::bakedPath(filepath)))) {
+        return filepath;
+    }
+
+    setState(State::Hashing, times);
+    bool upToDate = SceneCache::isUpToDate(filepath);
+    times.mark("Hashing");
+
+    if (!upToDate && cacheMode == CacheMode::Bake) {
+        setState(State::Baking, times);
+        try {
+            SceneCache::bake(filepath);
+            upToDate = true;
+        }
+        catch (const std::exception &e) {
+            // the source still loads fine, just slower
+            std::cerr << e.what() << std::endl;
+        }
+        times.mark("Baking");
+    }
+
+    if (!upToDate) {
+        return filepath;
+    }
+    std::unique_lock lock(m_mutex);
+    m_progress.fromBakedCopy = true;
+    return SceneCache::bakedPath(filepath);
+}
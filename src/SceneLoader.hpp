@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Options.hpp"
+#include "StartupTimes.hpp"
+
+#include "Vitrae/Assets/Scene.hpp"
+#include "Vitrae/Collections/ComponentRoot.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace Vitrae;
+
+/**
+ * Loads the scene file and prepares its props,
+ * reporting the progress to other threads while it works
+ */
+class SceneLoader
+{
+  public:
+    enum class State
+    {
+        Pending,
+        Hashing,
+        Baking,
+        Parsing,
+        Scaling,
+        Amplifying,
+        Done,
+        Failed
+    };
+
+    struct Progress
+    {
+        State state = State::Pending;
+        std::chrono::steady_clock::time_point startTime;
+        std::vector<StartupTimes::Stage> stages;
+        std::size_t propCount = 0;
+        // whether the baked copy was loaded instead of the source file
+        bool fromBakedCopy = false;
+        std::string error;
+    };
+
+    SceneLoader() = default;
+
+    enum class CacheMode
+    {
+        // always load the source file
+        Ignore,
+        // load the baked copy if it's up to date
+        Use,
+        // rebake the copy if it's out of date, then load it
+        Bake
+    };
+
+    /**
+     * Loads the scene on the calling thread, which needs the renderer enabled
+     * @throws the loading errors, after recording them in the progress
+     */
+    dynasma::FirmPtr<Scene> load(ComponentRoot &root, const std::filesystem::path &filepath,
+                                 float scale, CacheMode cacheMode,
+                                 const Amplification &amplification);
+
+    Progress getProgress() const;
+
+  private:
+    mutable std::mutex m_mutex;
+    Progress m_progress;
+
+    void setState(State state, const StartupTimes &times);
+    // @returns the baked copy to load instead of the source, or the source
+    std::filesystem::path resolveCache(const std::filesystem::path &filepath,
+                                       CacheMode cacheMode, StartupTimes &times);
+};
@@ -1,6 +1,8 @@
 #include "SettingsWindow.h"
 #include "Vitrae/Collections/MethodCollection.hpp"
 
+#include <QtCore/QSignalBlocker>
+#include <QtCore/QStringList>
 #include <QtWidgets/QCheckBox>
 #include <QtWidgets/QColorDialog>
 #include <QtWidgets/QComboBox>
@@ -8,54 +10,128 @@
 #include <QtWidgets/QMessageBox>
 #include <QtWidgets/QPushButton>
 
-#include <mutex>
+#include <variant>
+
+namespace
+{
+QString percentilesToString(const FrameTimePercentiles &percentiles)
+{
+    auto ms = [](FrameTimeHistogram::Duration d) { return QString::number(d.count() * 1000.0); };
+    return "p50 " + ms(percentiles.p50) + "ms, p90 " + ms(percentiles.p90) + "ms, p99 " +
+           ms(percentiles.p99) + "ms, p99.9 " + ms(percentiles.p999) + "ms, max " +
+           ms(percentiles.max) + "ms";
+}
+
+void setTextIfChanged(QLabel *p_label, const QString &text)
+{
+    if (p_label->text() != text) {
+        p_label->setText(text);
+    }
+}
+} // namespace
 
 SettingsWindow::SettingsWindow(AssetCollection &assetCollection, Status &status)
-    : QMainWindow(), ui(), m_assetCollection(assetCollection), m_status(status), inputSpecshash(0)
+    : QMainWindow(), ui(), m_assetCollection(assetCollection), m_status(status),
+      inputSpecshash(0), m_lightColorPrimary(-1.0f), m_lightColorAmbient(-1.0f),
+      m_sceneLoadingFinished(false), m_memorySampleCount(0), m_resolutionSampleCount(0)
 {
     ui.setupUi(this);
 
-    updateValues();
+    mp_memoryPlot = new HistoryPlot(ui.memory_group);
+    ui.memory_layout->addRow(mp_memoryPlot);
+    {
+        QSignalBlocker blocker(ui.memoryBudget);
+        ui.memoryBudget->setValue(
+            (int)(assetCollection.memoryBudget.getStats().budgetBytes / (1024 * 1024)));
+    }
+    connect(ui.memoryBudget, QOverload<int>::of(&QSpinBox::valueChanged), [this](int mib) {
+        m_assetCollection.queueCommand([bytes = (std::size_t)mib * 1024 * 1024](
+                                           AssetCollection &collection) {
+            collection.memoryBudget.setBudget(bytes);
+        });
+    });
+
+    {
+        QSignalBlocker blocker(ui.lodTarget);
+        ui.lodTarget->setValue(assetCollection.lodController.getTarget().count() * 1000.0);
+    }
+    connect(ui.lodTarget, QOverload<double>::of(&QDoubleSpinBox::valueChanged), [this](double ms) {
+        m_assetCollection.queueCommand([ms](AssetCollection &collection) {
+            collection.lodController.setTarget(std::chrono::duration<double>(ms / 1000.0));
+        });
+    });
+
+    {
+        QSignalBlocker modeBlocker(ui.pacingMode);
+        QSignalBlocker rateBlocker(ui.pacingRate);
+        // the items are in the order of the modes
+        ui.pacingMode->setCurrentIndex((int)assetCollection.framePacer.getMode());
+        ui.pacingRate->setValue(assetCollection.framePacer.getTargetRate());
+        ui.pacingRate->setEnabled(assetCollection.framePacer.getMode() ==
+                                  FramePacer::Mode::FixedRate);
+    }
+    auto queuePacing = [this]() {
+        auto mode = (FramePacer::Mode)ui.pacingMode->currentIndex();
+        ui.pacingRate->setEnabled(mode == FramePacer::Mode::FixedRate);
+        m_assetCollection.queueCommand(
+            [mode, rate = ui.pacingRate->value()](AssetCollection &collection) {
+                collection.setFramePacing(mode, rate);
+            });
+    };
+    connect(ui.pacingMode, QOverload<int>::of(&QComboBox::currentIndexChanged), queuePacing);
+    connect(ui.pacingRate, QOverload<double>::of(&QDoubleSpinBox::valueChanged), queuePacing);
+
+    ui.comparison_group->setVisible(!assetCollection.comparisonViews.empty());
+
+    mp_resolutionPlot = new HistoryPlot(ui.resolution_group);
+    // native resolution
+    mp_resolutionPlot->setLimit(1.0);
+    ui.resolution_layout->addRow(mp_resolutionPlot);
 
     connect(ui.light_dir_x, QOverload<double>::of(&QDoubleSpinBox::valueChanged), [this](double d) {
-        std::unique_lock lock1(this->m_assetCollection.accessMutex);
-        this->m_assetCollection.p_scene->light.direction.x = d;
+        m_assetCollection.queueCommand(
+            [d](AssetCollection &collection) { collection.p_scene->light.direction.x = d; });
     });
     connect(ui.light_dir_y, QOverload<double>::of(&QDoubleSpinBox::valueChanged), [this](double d) {
-        std::unique_lock lock1(this->m_assetCollection.accessMutex);
-        this->m_assetCollection.p_scene->light.direction.y = d;
+        m_assetCollection.queueCommand(
+            [d](AssetCollection &collection) { collection.p_scene->light.direction.y = d; });
     });
     connect(ui.light_dir_z, QOverload<double>::of(&QDoubleSpinBox::valueChanged), [this](double d) {
-        std::unique_lock lock1(this->m_assetCollection.accessMutex);
-        this->m_assetCollection.p_scene->light.direction.z = d;
+        m_assetCollection.queueCommand(
+            [d](AssetCollection &collection) { collection.p_scene->light.direction.z = d; });
     });
     connect(ui.light_color, &QPushButton::clicked, [this]() {
-        std::unique_lock lock1(this->m_assetCollection.accessMutex);
-        QColor lightColor = QColor::fromRgbF(m_assetCollection.p_scene->light.color_primary.r,
-                                             m_assetCollection.p_scene->light.color_primary.g,
-                                             m_assetCollection.p_scene->light.color_primary.b);
-        QColor c = QColorDialog::getColor(lightColor, this);
-        m_assetCollection.p_scene->light.color_primary = {c.redF(), c.greenF(), c.blueF()};
+        QColor c = QColorDialog::getColor(
+            QColor::fromRgbF(m_lightColorPrimary.r, m_lightColorPrimary.g, m_lightColorPrimary.b),
+            this);
+        if (c.isValid()) {
+            m_assetCollection.queueCommand([color = glm::vec3{c.redF(), c.greenF(), c.blueF()}](
+                                               AssetCollection &collection) {
+                collection.p_scene->light.color_primary = color;
+            });
+        }
     });
     connect(ui.ambient_color, &QPushButton::clicked, [this]() {
-        std::unique_lock lock1(this->m_assetCollection.accessMutex);
-        QColor lightColor = QColor::fromRgbF(m_assetCollection.p_scene->light.color_ambient.r,
-                                             m_assetCollection.p_scene->light.color_ambient.g,
-                                             m_assetCollection.p_scene->light.color_ambient.b);
-        QColor c = QColorDialog::getColor(lightColor, this);
-        m_assetCollection.p_scene->light.color_ambient = {c.redF(), c.greenF(), c.blueF()};
+        QColor c = QColorDialog::getColor(
+            QColor::fromRgbF(m_lightColorAmbient.r, m_lightColorAmbient.g, m_lightColorAmbient.b),
+            this);
+        if (c.isValid()) {
+            m_assetCollection.queueCommand([color = glm::vec3{c.redF(), c.greenF(), c.blueF()}](
+                                               AssetCollection &collection) {
+                collection.p_scene->light.color_ambient = color;
+            });
+        }
     });
     connect(ui.rebuildButton, &QPushButton::clicked, [this]() {
-        std::unique_lock lock1(this->m_assetCollection.accessMutex);
-        m_assetCollection.comp.rebuildPipeline();
-        m_status.resetPipeline();
+        m_assetCollection.queueCommand(
+            [](AssetCollection &collection) { collection.invalidatePipeline(); });
     });
     /*connect(ui.shadowMapSize, &QComboBox::currentTextChanged, [this](const QString &str) {
-        this->m_assetCollection.comp.parameters.set("ShadowMapSize",
+        this->m_assetCollection.p_comp->parameters.set("ShadowMapSize",
                                                     glm::vec2{str.toInt(), str.toInt()});
         this->m_assetCollection.shouldReloadPipelines = true;
     });
-    m_assetCollection.comp.parameters.set("ShadowMapSize",
+    m_assetCollection.p_comp->parameters.set("ShadowMapSize",
                                           glm::vec2{ui.shadowMapSize->currentText().toInt(),
                                                     ui.shadowMapSize->currentText().toInt()});*/
 
@@ -113,74 +189,251 @@ SettingsWindow::SettingsWindow(AssetCollection &assetCollection, Status &status)
         ui.shading_methods_layout->addRow(QString::fromStdString(target), p_combobox);
     }
 
-    connect(ui.rebuildButton, &QPushButton::clicked, [this]() {
-        std::unique_lock lock1(this->m_assetCollection.accessMutex);
-        this->m_assetCollection.shouldReloadPipelines = true;
-    });
-
+    // the settings are listed from the first snapshot
     applyCompositorSettings();
-
-    // list settings
-    relistSettings();
 }
 
 SettingsWindow::~SettingsWindow() {}
 
-void SettingsWindow::updateValues()
+void SettingsWindow::updateValues(const FrameSnapshot &snapshot)
 {
-    ui.totalAvgDuraion->setText(QString::number(m_status.totalAvgFrameDuration.count() * 1000.0) +
-                                "ms");
-    ui.totalFPS->setText(QString::number(m_status.totalFPS));
-    ui.currentAvgDuration->setText(
-        QString::number(m_status.currentAvgFrameDuration.count() * 1000.0) + "ms");
-    ui.currentFPS->setText(QString::number(m_status.currentFPS));
-    ui.pipelineAvg->setText(QString::number(m_status.pipelineAvgFrameDuration.count() * 1000.0) +
-                            "ms");
-    ui.pipelineFPS->setText(QString::number(m_status.pipelineFPS));
+    setTextIfChanged(ui.totalAvgDuraion,
+                     QString::number(snapshot.totalAvgFrameDuration.count() * 1000.0) + "ms");
+    setTextIfChanged(ui.totalFPS, QString::number(snapshot.totalFPS));
+    setTextIfChanged(ui.currentAvgDuration,
+                     QString::number(snapshot.currentAvgFrameDuration.count() * 1000.0) + "ms");
+    setTextIfChanged(ui.currentFPS, QString::number(snapshot.currentFPS));
+    setTextIfChanged(ui.pipelineAvg,
+                     QString::number(snapshot.pipelineAvgFrameDuration.count() * 1000.0) + "ms");
+    setTextIfChanged(ui.pipelineFPS, QString::number(snapshot.pipelineFPS));
+    setTextIfChanged(ui.currentPercentiles, percentilesToString(snapshot.currentPercentiles));
+    setTextIfChanged(ui.pipelinePercentiles, percentilesToString(snapshot.pipelinePercentiles));
+    setTextIfChanged(ui.totalPercentiles, percentilesToString(snapshot.totalPercentiles));
+    setTextIfChanged(ui.pipelineBuild,
+                     QString::number(snapshot.pipelineBuildDuration.count() * 1000.0) + "ms (" +
+                         QString::number(snapshot.pipelineBuildCount) + " builds)" +
+                         (snapshot.pipelineBuilding ? ", building" : ""));
+    if (snapshot.cullingStats) {
+        const FrustumCuller::Stats &cullingStats = *snapshot.cullingStats;
+        setTextIfChanged(ui.culling,
+                         QString::number(cullingStats.visibleCount) + " visible, " +
+                             QString::number(cullingStats.propCount - cullingStats.visibleCount) +
+                             " culled (" +
+                             QString::number(cullingStats.cullDuration.count() * 1000.0, 'f', 3) +
+                             "ms)");
+    } else {
+        setTextIfChanged(ui.culling, "off");
+    }
+    if (snapshot.occlusionStats) {
+        const OcclusionCuller::Stats &occlusionStats = *snapshot.occlusionStats;
+        double rejectionRate = occlusionStats.testedCount
+                                   ? (double)occlusionStats.occludedCount /
+                                         occlusionStats.testedCount * 100.0
+                                   : 0.0;
+        setTextIfChanged(
+            ui.occlusion,
+            QString::number(occlusionStats.occludedCount) + " hidden (" +
+                QString::number(rejectionRate, 'f', 1) + "%) by " +
+                QString::number(occlusionStats.occluderCount) + " occluders, rasterize " +
+                QString::number(occlusionStats.rasterizeDuration.count() * 1000.0, 'f', 3) +
+                "ms, test " +
+                QString::number(occlusionStats.testDuration.count() * 1000.0, 'f', 3) + "ms");
+    } else {
+        setTextIfChanged(ui.occlusion, "off");
+    }
+    setTextIfChanged(ui.lodThreshold,
+                     QString::number(snapshot.lodThreshold, 'f', 2) + " px per element");
+    setTextIfChanged(ui.primitiveCount, snapshot.primitiveCount
+                                            ? QString::number(*snapshot.primitiveCount)
+                                            : QString("unknown"));
+    if (snapshot.resolutionScale) {
+        setTextIfChanged(ui.resolutionScale,
+                         QString::number(*snapshot.resolutionScale, 'f', 2) + " (" +
+                             QString::number(snapshot.renderSize.x) + "x" +
+                             QString::number(snapshot.renderSize.y) + ")");
+        if (snapshot.resolutionSampleCount != m_resolutionSampleCount) {
+            m_resolutionSampleCount = snapshot.resolutionSampleCount;
+            mp_resolutionPlot->addValue(*snapshot.resolutionScale);
+        }
+    } else {
+        setTextIfChanged(ui.resolutionScale, "native");
+    }
+    if (!snapshot.composeTimings.empty()) {
+        QStringList lines;
+        double mainMs = snapshot.composeTimings[0].meanDuration.count() * 1000.0;
+        for (std::size_t i = 0; i < snapshot.composeTimings.size(); i++) {
+            const ComposeTiming &timing = snapshot.composeTimings[i];
+            QString line = QString::fromStdString(timing.name) + ": ";
+            if (!timing.built) {
+                line += "building...";
+            } else {
+                double ms = timing.meanDuration.count() * 1000.0;
+                line += QString::number(ms, 'f', 3) + "ms";
+                // relative to the main pipeline
+                if (i > 0) {
+                    line += QString(" (%1%2ms)")
+                                .arg(ms >= mainMs ? "+" : "")
+                                .arg(ms - mainMs, 0, 'f', 3);
+                }
+            }
+            lines.append(line);
+        }
+        setTextIfChanged(ui.composeTimings, lines.join("\n"));
+    }
+    const FramePacer::Stats &pacingStats = snapshot.pacingStats;
+    setTextIfChanged(ui.frameInterval,
+                     QString::number(pacingStats.avgInterval.count() * 1000.0, 'f', 2) +
+                         "ms avg, " +
+                         QString::number(pacingStats.intervalJitter.count() * 1000.0, 'f', 3) +
+                         "ms jitter, p99 " +
+                         QString::number(pacingStats.intervalPercentiles.p99.count() * 1000.0,
+                                         'f', 2) +
+                         "ms");
+    setTextIfChanged(ui.pacingIdle,
+                     QString::number((1.0 - pacingStats.idleFraction()) * 100.0, 'f', 1) +
+                         "% busy, " + QString::number(pacingStats.idleFraction() * 100.0, 'f', 1) +
+                         "% idle");
+    const InputLatencyTracker::Stats &inputLatencyStats = snapshot.inputLatencyStats;
+    if (inputLatencyStats.inputCount > 0) {
+        setTextIfChanged(ui.inputToCompose, percentilesToString(inputLatencyStats.toCompose));
+        setTextIfChanged(ui.inputToPresent, percentilesToString(inputLatencyStats.toPresent));
+        setTextIfChanged(ui.inputFrameDelay,
+                         QString::number(inputLatencyStats.avgFrameDelay, 'f', 2) + " avg, " +
+                             QString::number(inputLatencyStats.maxFrameDelay) + " max (" +
+                             QString::number(inputLatencyStats.inputCount) + " inputs)");
+    } else {
+        setTextIfChanged(ui.inputToCompose, "no input yet");
+        setTextIfChanged(ui.inputToPresent, "no input yet");
+        setTextIfChanged(ui.inputFrameDelay, "no input yet");
+    }
+    const MemoryBudget::Stats &memoryStats = snapshot.memoryStats;
+    auto mib = [](std::size_t bytes) { return (double)bytes / (1024.0 * 1024.0); };
+    if (memoryStats.residentBytes > 0) {
+        setTextIfChanged(ui.memoryResident,
+                         QString::number(mib(memoryStats.residentBytes), 'f', 1) + " MiB");
+    } else {
+        setTextIfChanged(ui.memoryResident, "unknown");
+    }
+    setTextIfChanged(ui.memoryEvictions,
+                     QString::number(memoryStats.evictionCount) + " (" +
+                         QString::number(mib(memoryStats.evictedBytes), 'f', 1) + " MiB less RSS)");
+    if (memoryStats.sampleCount != m_memorySampleCount) {
+        m_memorySampleCount = memoryStats.sampleCount;
+        mp_memoryPlot->addValue(mib(memoryStats.residentBytes));
+        mp_memoryPlot->setLimit(mib(memoryStats.budgetBytes));
+    }
+    setTextIfChanged(ui.pipelineWarmup,
+                     QString::number(snapshot.pipelineWarmupFrameCount) + " frames excluded (" +
+                         QString::number(snapshot.pipelineWarmupDuration.count() * 1000.0) +
+                         "ms)" + (snapshot.pipelineWarmingUp ? ", still warming up" : ""));
 
     // update spinboxes and other controls
-    if (ui.camera_x->value() != m_assetCollection.p_scene->camera.position.x) {
-        ui.camera_x->setValue(m_assetCollection.p_scene->camera.position.x);
+    if (ui.camera_x->value() != snapshot.cameraPosition.x) {
+        ui.camera_x->setValue(snapshot.cameraPosition.x);
     }
-    if (ui.camera_y->value() != m_assetCollection.p_scene->camera.position.y) {
-        ui.camera_y->setValue(m_assetCollection.p_scene->camera.position.y);
+    if (ui.camera_y->value() != snapshot.cameraPosition.y) {
+        ui.camera_y->setValue(snapshot.cameraPosition.y);
     }
-    if (ui.camera_z->value() != m_assetCollection.p_scene->camera.position.z) {
-        ui.camera_z->setValue(m_assetCollection.p_scene->camera.position.z);
+    if (ui.camera_z->value() != snapshot.cameraPosition.z) {
+        ui.camera_z->setValue(snapshot.cameraPosition.z);
     }
-    auto cameraDirVector = m_assetCollection.p_scene->camera.rotation * glm::vec3(0, 0, 1);
-    ui.camera_dir_x->setText(QString::number(cameraDirVector.x));
-    ui.camera_dir_y->setText(QString::number(cameraDirVector.y));
-    ui.camera_dir_z->setText(QString::number(cameraDirVector.z));
-    if (ui.light_dir_x->value() != m_assetCollection.p_scene->light.direction.x) {
-        ui.light_dir_x->setValue(m_assetCollection.p_scene->light.direction.x);
+    auto cameraDirVector = snapshot.cameraRotation * glm::vec3(0, 0, 1);
+    setTextIfChanged(ui.camera_dir_x, QString::number(cameraDirVector.x));
+    setTextIfChanged(ui.camera_dir_y, QString::number(cameraDirVector.y));
+    setTextIfChanged(ui.camera_dir_z, QString::number(cameraDirVector.z));
+    // don't overwrite the user's edits before the render thread applied them
+    if (!m_assetCollection.hasPendingCommands()) {
+        QSignalBlocker blockX(ui.light_dir_x), blockY(ui.light_dir_y), blockZ(ui.light_dir_z);
+        if (ui.light_dir_x->value() != snapshot.lightDirection.x) {
+            ui.light_dir_x->setValue(snapshot.lightDirection.x);
+        }
+        if (ui.light_dir_y->value() != snapshot.lightDirection.y) {
+            ui.light_dir_y->setValue(snapshot.lightDirection.y);
+        }
+        if (ui.light_dir_z->value() != snapshot.lightDirection.z) {
+            ui.light_dir_z->setValue(snapshot.lightDirection.z);
+        }
     }
-    if (ui.light_dir_y->value() != m_assetCollection.p_scene->light.direction.y) {
-        ui.light_dir_y->setValue(m_assetCollection.p_scene->light.direction.y);
+    if (snapshot.lightColorPrimary != m_lightColorPrimary) {
+        m_lightColorPrimary = snapshot.lightColorPrimary;
+        QColor lightColor(m_lightColorPrimary.r * 255.0, m_lightColorPrimary.g * 255.0,
+                          m_lightColorPrimary.b * 255.0);
+        ui.light_color->setPalette(QPalette(Qt::black, lightColor, lightColor, lightColor,
+                                            lightColor, Qt::black, lightColor));
     }
-    if (ui.light_dir_z->value() != m_assetCollection.p_scene->light.direction.z) {
-        ui.light_dir_z->setValue(m_assetCollection.p_scene->light.direction.z);
+    if (snapshot.lightColorAmbient != m_lightColorAmbient) {
+        m_lightColorAmbient = snapshot.lightColorAmbient;
+        QColor lightColor(m_lightColorAmbient.r * 255.0, m_lightColorAmbient.g * 255.0,
+                          m_lightColorAmbient.b * 255.0);
+        ui.ambient_color->setPalette(QPalette(Qt::black, lightColor, lightColor, lightColor,
+                                              lightColor, Qt::black, lightColor));
+    }
+
+    if (snapshot.p_inputSettings) {
+        relistSettings(*snapshot.p_inputSettings);
     }
-    QColor lightColor(m_assetCollection.p_scene->light.color_primary.r * 255.0,
-                      m_assetCollection.p_scene->light.color_primary.g * 255.0,
-                      m_assetCollection.p_scene->light.color_primary.b * 255.0);
-    ui.light_color->setPalette(
-        QPalette(Qt::black, lightColor, lightColor, lightColor, lightColor, Qt::black, lightColor));
-    lightColor = QColor(m_assetCollection.p_scene->light.color_ambient.r * 255.0,
-                        m_assetCollection.p_scene->light.color_ambient.g * 255.0,
-                        m_assetCollection.p_scene->light.color_ambient.b * 255.0);
-    ui.ambient_color->setPalette(
-        QPalette(Qt::black, lightColor, lightColor, lightColor, lightColor, Qt::black, lightColor));
-
-    relistSettings();
 }
 
-void SettingsWindow::relistSettings()
+void SettingsWindow::updateSceneLoading(const SceneLoader::Progress &progress)
 {
-    if (m_assetCollection.compositorInputsHash != inputSpecshash) {
-        std::unique_lock lock1(this->m_assetCollection.accessMutex);
+    if (m_sceneLoadingFinished) {
+        return;
+    }
+
+    auto ms = [](std::chrono::duration<double> d) { return QString::number(d.count() * 1000.0); };
 
-        inputSpecshash = m_assetCollection.comp.getInputSpecs().getHash();
+    QString stages;
+    for (auto &stage : progress.stages) {
+        stages += (stages.isEmpty() ? "" : ", ") + QString::fromStdString(stage.name) + " " +
+                  ms(stage.duration) + "ms";
+    }
+
+    switch (progress.state) {
+    case SceneLoader::State::Pending:
+        setTextIfChanged(ui.sceneLoading, "waiting");
+        break;
+    case SceneLoader::State::Hashing:
+        setTextIfChanged(ui.sceneLoading, "checking the baked copy...");
+        break;
+    case SceneLoader::State::Baking:
+        setTextIfChanged(ui.sceneLoading,
+                         "baking... " +
+                             ms(std::chrono::steady_clock::now() - progress.startTime) + "ms");
+        break;
+    case SceneLoader::State::Parsing:
+        setTextIfChanged(ui.sceneLoading,
+                         QString(progress.fromBakedCopy ? "loading the baked copy... "
+                                                        : "parsing the file... ") +
+                             ms(std::chrono::steady_clock::now() - progress.startTime) + "ms");
+        break;
+    case SceneLoader::State::Scaling:
+        setTextIfChanged(ui.sceneLoading, "preparing " + QString::number(progress.propCount) +
+                                              " props... (" + stages + ")");
+        break;
+    case SceneLoader::State::Amplifying:
+        setTextIfChanged(ui.sceneLoading,
+                         "replicating " + QString::number(progress.propCount) + " props... (" +
+                             stages + ")");
+        break;
+    case SceneLoader::State::Done:
+        setTextIfChanged(ui.sceneLoading,
+                         QString::number(progress.propCount) + " props" +
+                             (progress.fromBakedCopy ? " from the baked copy" : "") + " (" +
+                             stages + ")");
+        m_sceneLoadingFinished = true;
+        break;
+    case SceneLoader::State::Failed:
+        setTextIfChanged(ui.sceneLoading,
+                         "failed: " + QString::fromStdString(progress.error));
+        m_sceneLoadingFinished = true;
+        break;
+    }
+}
+
+void SettingsWindow::relistSettings(const InputSettings &settings)
+{
+    if (settings.specsHash != inputSpecshash) {
+        inputSpecshash = settings.specsHash;
 
         // remove old inputs
         while (ui.settings_layout->count() > 0) {
@@ -188,56 +441,45 @@ void SettingsWindow::relistSettings()
         }
 
         // add new inputs
-        for (auto &spec : m_assetCollection.comp.getInputSpecs().getSpecList()) {
-            if (spec.typeInfo == TYPE_INFO<float>) {
+        bool addedDefaults = false;
+        for (auto &spec : settings.inputs) {
+            if (std::holds_alternative<float>(spec.value)) {
                 auto p_spinbox = new QDoubleSpinBox(ui.settings_group);
                 p_spinbox->setSingleStep(0.1);
                 p_spinbox->setMinimum(std::numeric_limits<float>::lowest());
                 p_spinbox->setMaximum(std::numeric_limits<float>::max());
-                if (auto vp = m_assetCollection.comp.parameters.getPtr(spec.name); vp) {
-                    p_spinbox->setValue(vp->get<float>());
-                }
+                p_spinbox->setValue(std::get<float>(spec.value));
 
-                connect(
-                    p_spinbox, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
-                    [&m_assetCollection = this->m_assetCollection, name = spec.name](double val) {
-                        m_assetCollection.comp.parameters.set(name, (float)val);
-                    });
+                connect(p_spinbox, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+                        [this, name = spec.name](double val) { queueParameter(name, (float)val); });
 
                 ui.settings_layout->addRow(QString::fromStdString(spec.name), p_spinbox);
-            } else if (spec.typeInfo == TYPE_INFO<double>) {
+            } else if (std::holds_alternative<double>(spec.value)) {
                 auto p_spinbox = new QDoubleSpinBox(ui.settings_group);
                 p_spinbox->setSingleStep(0.1);
                 p_spinbox->setMinimum(std::numeric_limits<double>::lowest());
                 p_spinbox->setMaximum(std::numeric_limits<double>::max());
-                if (auto vp = m_assetCollection.comp.parameters.getPtr(spec.name); vp) {
-                    p_spinbox->setValue(vp->get<double>());
-                }
+                p_spinbox->setValue(std::get<double>(spec.value));
 
-                connect(
-                    p_spinbox, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
-                    [&m_assetCollection = this->m_assetCollection, name = spec.name](double val) {
-                        m_assetCollection.comp.parameters.set(name, (double)val);
-                    });
+                connect(p_spinbox, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+                        [this, name = spec.name](double val) { queueParameter(name, val); });
 
                 ui.settings_layout->addRow(QString::fromStdString(spec.name), p_spinbox);
-            } else if (spec.typeInfo == TYPE_INFO<bool>) {
+            } else if (std::holds_alternative<bool>(spec.value)) {
                 auto p_checkbox = new QCheckBox(ui.settings_group);
-                if (auto vp = m_assetCollection.comp.parameters.getPtr(spec.name); vp) {
-                    p_checkbox->setChecked(vp->get<bool>());
-                }
+                p_checkbox->setChecked(std::get<bool>(spec.value));
                 connect(p_checkbox, &QCheckBox::toggled,
-                        [&m_assetCollection = this->m_assetCollection, name = spec.name](bool val) {
-                            m_assetCollection.comp.parameters.set(name, val);
-                        });
+                        [this, name = spec.name](bool val) { queueParameter(name, val); });
 
                 ui.settings_layout->addRow(QString::fromStdString(spec.name), p_checkbox);
-            } else if (spec.typeInfo == TYPE_INFO<std::int32_t>) {
+            } else if (std::holds_alternative<std::int32_t>(spec.value)) {
                 std::int32_t def = 1;
-                if (auto vp = m_assetCollection.comp.parameters.getPtr(spec.name); vp) {
-                    def = vp->get<std::int32_t>();
+                if (spec.isSet) {
+                    def = std::get<std::int32_t>(spec.value);
+                } else {
+                    queueParameter(spec.name, def);
+                    addedDefaults = true;
                 }
-                m_assetCollection.comp.parameters.set(spec.name, def);
 
                 auto p_spinbox = new QSpinBox(ui.settings_group);
                 p_spinbox->setSingleStep(1);
@@ -246,17 +488,19 @@ void SettingsWindow::relistSettings()
                 p_spinbox->setValue(def);
 
                 connect(p_spinbox, QOverload<int>::of(&QSpinBox::valueChanged),
-                        [&m_assetCollection = this->m_assetCollection, name = spec.name](int val) {
-                            m_assetCollection.comp.parameters.set(name, (std::int32_t)val);
+                        [this, name = spec.name](int val) {
+                            queueParameter(name, (std::int32_t)val);
                         });
 
                 ui.settings_layout->addRow(QString::fromStdString(spec.name), p_spinbox);
-            } else if (spec.typeInfo == TYPE_INFO<std::uint32_t>) {
+            } else if (std::holds_alternative<std::uint32_t>(spec.value)) {
                 std::uint32_t def = 1;
-                if (auto vp = m_assetCollection.comp.parameters.getPtr(spec.name); vp) {
-                    def = vp->get<std::uint32_t>();
+                if (spec.isSet) {
+                    def = std::get<std::uint32_t>(spec.value);
+                } else {
+                    queueParameter(spec.name, def);
+                    addedDefaults = true;
                 }
-                m_assetCollection.comp.parameters.set(spec.name, def);
 
                 if ((def & (def - 1)) == 0) { // if power of two
                     auto p_combobox = new QComboBox(ui.settings_group);
@@ -268,8 +512,7 @@ void SettingsWindow::relistSettings()
 
                     connect(p_combobox, &QComboBox::currentTextChanged,
                             [this, name = spec.name](const QString &str) {
-                                this->m_assetCollection.comp.parameters.set(
-                                    name, (std::uint32_t)str.toUInt());
+                                queueParameter(name, (std::uint32_t)str.toUInt());
                             });
 
                     ui.settings_layout->addRow(QString::fromStdString(spec.name), p_combobox);
@@ -279,20 +522,21 @@ void SettingsWindow::relistSettings()
                     p_spinbox->setMinimum(0);
                     p_spinbox->setMaximum(std::numeric_limits<int>::max());
                     p_spinbox->setValue(def);
-                    connect(
-                        p_spinbox, QOverload<int>::of(&QSpinBox::valueChanged),
-                        [&m_assetCollection = this->m_assetCollection, name = spec.name](int val) {
-                            m_assetCollection.comp.parameters.set(name, (std::uint32_t)val);
-                        });
+                    connect(p_spinbox, QOverload<int>::of(&QSpinBox::valueChanged),
+                            [this, name = spec.name](int val) {
+                                queueParameter(name, (std::uint32_t)val);
+                            });
 
                     ui.settings_layout->addRow(QString::fromStdString(spec.name), p_spinbox);
                 }
-            } else if (spec.typeInfo == TYPE_INFO<std::size_t>) {
+            } else if (std::holds_alternative<std::size_t>(spec.value)) {
                 std::size_t def = 1;
-                if (auto vp = m_assetCollection.comp.parameters.getPtr(spec.name); vp) {
-                    def = vp->get<std::size_t>();
+                if (spec.isSet) {
+                    def = std::get<std::size_t>(spec.value);
+                } else {
+                    queueParameter(spec.name, def);
+                    addedDefaults = true;
                 }
-                m_assetCollection.comp.parameters.set(spec.name, def);
 
                 if ((def & (def - 1)) == 0) { // if power of two
                     auto p_combobox = new QComboBox(ui.settings_group);
@@ -305,8 +549,7 @@ void SettingsWindow::relistSettings()
 
                     connect(p_combobox, &QComboBox::currentTextChanged,
                             [this, name = spec.name](const QString &str) {
-                                this->m_assetCollection.comp.parameters.set(
-                                    name, (std::size_t)str.toUInt());
+                                queueParameter(name, (std::size_t)str.toUInt());
                             });
 
                     ui.settings_layout->addRow(QString::fromStdString(spec.name), p_combobox);
@@ -316,20 +559,21 @@ void SettingsWindow::relistSettings()
                     p_spinbox->setMinimum(0);
                     p_spinbox->setMaximum(std::numeric_limits<int>::max());
                     p_spinbox->setValue(def);
-                    connect(
-                        p_spinbox, QOverload<int>::of(&QSpinBox::valueChanged),
-                        [&m_assetCollection = this->m_assetCollection, name = spec.name](int val) {
-                            m_assetCollection.comp.parameters.set(name, (std::size_t)val);
-                        });
+                    connect(p_spinbox, QOverload<int>::of(&QSpinBox::valueChanged),
+                            [this, name = spec.name](int val) {
+                                queueParameter(name, (std::size_t)val);
+                            });
 
                     ui.settings_layout->addRow(QString::fromStdString(spec.name), p_spinbox);
                 }
-            } else if (spec.typeInfo == TYPE_INFO<glm::uvec2>) {
+            } else if (std::holds_alternative<glm::uvec2>(spec.value)) {
                 glm::uvec2 def = {1, 1};
-                if (auto vp = m_assetCollection.comp.parameters.getPtr(spec.name); vp) {
-                    def = vp->get<glm::uvec2>();
+                if (spec.isSet) {
+                    def = std::get<glm::uvec2>(spec.value);
+                } else {
+                    queueParameter(spec.name, def);
+                    addedDefaults = true;
                 }
-                m_assetCollection.comp.parameters.set(spec.name, def);
 
                 if ((def.x & (def.x - 1)) == 0 && (def.y & (def.y - 1)) == 0) { // if power of two
                     auto p_combobox0 = new QComboBox(ui.settings_group);
@@ -345,7 +589,7 @@ void SettingsWindow::relistSettings()
 
                     auto callback = [this, name = spec.name, p_combobox0,
                                      p_combobox1](const QString &str) {
-                        this->m_assetCollection.comp.parameters.set(
+                        queueParameter(
                             name, glm::uvec2((std::uint32_t)p_combobox0->currentText().toUInt(),
                                              (std::uint32_t)p_combobox1->currentText().toUInt()));
                     };
@@ -369,9 +613,8 @@ void SettingsWindow::relistSettings()
                     p_spinbox1->setMaximum(std::numeric_limits<int>::max());
                     p_spinbox1->setValue(def.y);
                     auto callback = [this, name = spec.name, p_spinbox0, p_spinbox1](int val) {
-                        this->m_assetCollection.comp.parameters.set(
-                            name, glm::uvec2((std::uint32_t)p_spinbox0->value(),
-                                             (std::uint32_t)p_spinbox1->value()));
+                        queueParameter(name, glm::uvec2((std::uint32_t)p_spinbox0->value(),
+                                                        (std::uint32_t)p_spinbox1->value()));
                     };
 
                     connect(p_spinbox0, QOverload<int>::of(&QSpinBox::valueChanged), p_spinbox1,
@@ -388,23 +631,20 @@ void SettingsWindow::relistSettings()
             }
         }
 
-        // rebuild the pipeline
-        m_assetCollection.shouldReloadPipelines = true;
+        // the pipeline was built without the new defaults, so rebuild it after they're set
+        if (addedDefaults) {
+            m_assetCollection.queueCommand(
+                [](AssetCollection &collection) { collection.invalidatePipeline(); });
+        }
     }
 }
 
 void SettingsWindow::applyCompositorSettings()
 {
-    std::unique_lock lock1(m_assetCollection.accessMutex);
-
-    m_assetCollection.shouldReloadPipelines = true;
-
-    // Aliases
-    ParamAliases aliases(m_toBeAliases);
-    m_assetCollection.comp.setParamAliases(aliases);
-
-    // Outputs
-    m_assetCollection.comp.setDesiredProperties(m_desiredOutputs);
-
-    m_status.resetPipeline();
+    m_assetCollection.queueCommand([aliases = m_toBeAliases, desiredOutputs = m_desiredOutputs](
+                                       AssetCollection &collection) {
+        collection.pipelineConfig.aliases = aliases;
+        collection.pipelineConfig.desiredOutputs = desiredOutputs;
+        collection.shouldReloadPipelines = true;
+    });
 }
@@ -4,6 +4,8 @@
 
 #include <QtWidgets/QMainWindow>
 
+#include "HistoryPlot.h"
+#include "Snapshot.hpp"
 #include "Status.hpp"
 #include "assetCollection.hpp"
 
@@ -13,17 +15,39 @@ class SettingsWindow : public QMainWindow
     SettingsWindow(AssetCollection &assetCollection, Status &status);
     virtual ~SettingsWindow();
 
-    void updateValues();
-    void relistSettings();
+    void updateValues(const FrameSnapshot &snapshot);
+    void updateSceneLoading(const SceneLoader::Progress &progress);
+    // rebuilds the input widgets if the inputs changed; missing integer values get defaults
+    void relistSettings(const InputSettings &settings);
     void applyCompositorSettings();
 
   private:
     Ui::MainWindow ui;
 
+    // the parameter is changed by the render thread at the start of the next frame
+    template <class T> void queueParameter(const String &name, T value)
+    {
+        m_assetCollection.queueCommand([name, value](AssetCollection &collection) {
+            collection.setSharedParameter(name, value);
+        });
+    }
+
     AssetCollection &m_assetCollection;
     Status &m_status;
 
     std::map<String, String> m_toBeAliases;
     ParamList m_desiredOutputs;
     std::size_t inputSpecshash;
+
+    // last displayed colors, -1 until the first snapshot arrives
+    glm::vec3 m_lightColorPrimary;
+    glm::vec3 m_lightColorAmbient;
+
+    bool m_sceneLoadingFinished;
+
+    // resident memory over time, in MiB
+    HistoryPlot *mp_memoryPlot;
+    std::size_t m_memorySampleCount;
+    HistoryPlot *mp_resolutionPlot;
+    std::size_t m_resolutionSampleCount;
 };
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "ShaderCache.hpp"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+void setEnv(const char *name, const std::string &value)
+{
+#ifdef _WIN32
+    _putenv_s(name, value.c_str());
+#else
+    setenv(name, value.c_str(), 1);
+#endif
+}
+
+void setDefaultEnv(const char *name, const std::string &value)
+{
+    if (std::getenv(name)) {
+        return;
+    }
+    setEnv(name, value);
+}
+} // namespace
+
+void enableDriverShaderCache(const std::filesystem::path &directory)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    if (ec) {
+        std::cerr << "Cannot create shader cache directory " << directory << ": " << ec.message()
+                  << std::endl;
+        return;
+    }
+    std::string dir = directory.string();
+
+    // Mesa
+    setDefaultEnv("MESA_SHADER_CACHE_DISABLE", "false");
+    setDefaultEnv("MESA_SHADER_CACHE_DIR", dir);
+    setDefaultEnv("MESA_SHADER_CACHE_MAX_SIZE", "1G");
+
+    // NVIDIA
+    setDefaultEnv("__GL_SHADER_DISK_CACHE", "1");
+    setDefaultEnv("__GL_SHADER_DISK_CACHE_PATH", dir);
+    setDefaultEnv("__GL_SHADER_DISK_CACHE_SIZE", "1073741824");
+    setDefaultEnv("__GL_SHADER_DISK_CACHE_SKIP_CLEANUP", "1");
+}
+
+void disableDriverShaderCache()
+{
+    setEnv("MESA_SHADER_CACHE_DISABLE", "true");
+    setEnv("__GL_SHADER_DISK_CACHE", "0");
+}
+
+std::filesystem::path defaultShaderCacheDirectory()
+{
+    if (const char *xdgCache = std::getenv("XDG_CACHE_HOME"); xdgCache && *xdgCache) {
+        return std::filesystem::path(xdgCache) / "VitraeShowcase" / "shaders";
+    }
+#ifdef _WIN32
+    if (const char *localAppData = std::getenv("LOCALAPPDATA"); localAppData) {
+        return std::filesystem::path(localAppData) / "VitraeShowcase" / "shaders";
+    }
+#else
+    if (const char *home = std::getenv("HOME"); home) {
+        return std::filesystem::path(home) / ".cache" / "VitraeShowcase" / "shaders";
+    }
+#endif
+    return std::filesystem::temp_directory_path() / "VitraeShowcase" / "shaders";
+}
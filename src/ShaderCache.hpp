@@ -0,0 +1,22 @@
+#pragma once
+
+#include <filesystem>
+
+/**
+ * Points the OpenGL driver's on-disk shader cache to the given directory and enables it.
+ * Drivers key cached binaries by the shader source hash and their own build/GPU identity,
+ * so programs generated for the same methods are loaded instead of compiled on later runs.
+ * Must be called before the OpenGL plugin creates a context.
+ * Variables already set in the environment are left untouched
+ */
+void enableDriverShaderCache(const std::filesystem::path &directory);
+
+/**
+ * Turns the OpenGL driver's on-disk shader cache off, overriding the environment,
+ * so every program is compiled as on a cold start.
+ * Must be called before the OpenGL plugin creates a context
+ */
+void disableDriverShaderCache();
+
+// The per-user cache directory of the showcase
+std::filesystem::path defaultShaderCacheDirectory();
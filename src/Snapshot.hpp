@@ -0,0 +1,152 @@
+#pragma once
+
+#include "FramePacer.hpp"
+#include "FrameTimeHistogram.hpp"
+#include "FrustumCuller.hpp"
+#include "GpuProfiler.hpp"
+#include "InputLatencyTracker.hpp"
+#include "MemoryBudget.hpp"
+#include "OcclusionCuller.hpp"
+#include "PipelineCache.hpp"
+#include "ProfileNode.hpp"
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+/**
+ * Compose time of the main pipeline or a comparison view
+ */
+struct ComposeTiming
+{
+    std::string name;
+    bool built = false;
+    std::chrono::duration<double> meanDuration{0.0};
+};
+
+/**
+ * A compositor input of a type the settings window can edit
+ */
+struct InputSetting
+{
+    using Value = std::variant<float, double, bool, std::int32_t, std::uint32_t, std::size_t,
+                               glm::uvec2>;
+
+    std::string name;
+    // the settings window's default if not set
+    Value value;
+    bool isSet = false;
+};
+
+/**
+ * The editable inputs of the main pipeline, collected whenever its input specs change
+ */
+struct InputSettings
+{
+    std::size_t specsHash = 0;
+    std::vector<InputSetting> inputs;
+};
+
+/**
+ * Immutable copy of everything the GUI displays, published by the render thread once per frame
+ */
+struct FrameSnapshot
+{
+    std::size_t frameNumber = 0;
+
+    // Status
+    std::chrono::duration<double> totalAvgFrameDuration{0.0};
+    float totalFPS = 0.0f;
+    FrameTimePercentiles totalPercentiles;
+    std::chrono::duration<double> currentAvgFrameDuration{0.0};
+    float currentFPS = 0.0f;
+    FrameTimePercentiles currentPercentiles;
+    std::chrono::duration<double> pipelineAvgFrameDuration{0.0};
+    float pipelineFPS = 0.0f;
+    FrameTimePercentiles pipelinePercentiles;
+    bool pipelineWarmingUp = false;
+    std::size_t pipelineWarmupFrameCount = 0;
+    std::chrono::duration<double> pipelineWarmupDuration{0.0};
+    std::chrono::duration<double> pipelineBuildDuration{0.0};
+    std::size_t pipelineBuildCount = 0;
+    bool pipelineBuilding = false;
+    PipelineCache::Stats pipelineCacheStats;
+    MemoryBudget::Stats memoryStats;
+    // without culling, all props are rendered
+    std::optional<FrustumCuller::Stats> cullingStats;
+    std::optional<OcclusionCuller::Stats> occlusionStats;
+    float lodThreshold = 0.0f;
+    // drawn in the latest counted frame, including all passes
+    std::optional<std::uint64_t> primitiveCount;
+    // without dynamic resolution, frames are rendered at the display size
+    std::optional<float> resolutionScale;
+    std::size_t resolutionSampleCount = 0;
+    glm::uvec2 renderSize{0};
+    FramePacer::Mode pacingMode = FramePacer::Mode::Uncapped;
+    double pacingTargetRate = 0.0;
+    FramePacer::Stats pacingStats;
+    // the main pipeline first; empty without comparison views
+    std::vector<ComposeTiming> composeTimings;
+    InputLatencyTracker::Stats inputLatencyStats;
+    std::shared_ptr<const ProfileNode> p_profileTree;
+    std::shared_ptr<const GpuTimes> p_gpuTimes;
+    // replaced, never modified; null until the first pipeline is composed
+    std::shared_ptr<const InputSettings> p_inputSettings;
+
+    // Scene
+    glm::vec3 cameraPosition{0.0f};
+    glm::quat cameraRotation{1.0f, 0.0f, 0.0f, 0.0f};
+    glm::vec3 lightDirection{0.0f};
+    glm::vec3 lightColorPrimary{0.0f};
+    glm::vec3 lightColorAmbient{0.0f};
+};
+
+/**
+ * Lock-free latest-value channel from one writer thread to one reader thread.
+ * Uses three buffers so the writer always has a free one to fill
+ * while the reader holds on to the last published one
+ */
+template <class T> class SnapshotBuffer
+{
+  public:
+    SnapshotBuffer() : m_writeIndex(0), m_middle(1), m_readIndex(2) {}
+
+    // writer side
+    T &writeBuffer() { return m_buffers[m_writeIndex]; }
+    void publish()
+    {
+        m_writeIndex = m_middle.exchange(m_writeIndex | FRESH_BIT, std::memory_order_acq_rel) &
+                       INDEX_MASK;
+    }
+
+    // reader side
+    // @returns whether a newer snapshot was received since the last call
+    bool receive()
+    {
+        if (!(m_middle.load(std::memory_order_relaxed) & FRESH_BIT)) {
+            return false;
+        }
+        m_readIndex = m_middle.exchange(m_readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+    const T &readBuffer() const { return m_buffers[m_readIndex]; }
+
+  private:
+    static constexpr std::uint8_t INDEX_MASK = 0x3;
+    static constexpr std::uint8_t FRESH_BIT = 0x4;
+
+    std::array<T, 3> m_buffers;
+    std::uint8_t m_writeIndex;
+    std::atomic<std::uint8_t> m_middle;
+    std::uint8_t m_readIndex;
+};
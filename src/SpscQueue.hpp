@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ * Neither side ever blocks; tryPush fails when the queue is full, tryPop when it's empty
+ */
+template <class T, std::size_t Capacity> class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+
+  public:
+    SpscQueue() : m_head(0), m_tail(0) {}
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    // producer side
+    bool tryPush(T &&value)
+    {
+        std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        m_slots[tail & MASK] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side
+    bool tryPop(T &out)
+    {
+        std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = std::move(m_slots[head & MASK]);
+        m_slots[head & MASK] = T();
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+  private:
+    static constexpr std::size_t MASK = Capacity - 1;
+
+    // head and tail are on separate cache lines so producer and consumer don't false-share
+    alignas(64) std::atomic<std::size_t> m_head;
+    alignas(64) std::atomic<std::size_t> m_tail;
+    alignas(64) std::array<T, Capacity> m_slots;
+};
@@ -0,0 +1,28 @@
+#include "StartupTimes.hpp"
+
+StartupTimes::StartupTimes() : m_lastTimeStamp(std::chrono::steady_clock::now()) {}
+
+void StartupTimes::mark(std::string name)
+{
+    auto now = std::chrono::steady_clock::now();
+    stages.push_back(Stage{std::move(name), now - m_lastTimeStamp});
+    m_lastTimeStamp = now;
+}
+
+std::chrono::duration<double> StartupTimes::total() const
+{
+    std::chrono::duration<double> sum(0.0);
+    for (auto &stage : stages) {
+        sum += stage.duration;
+    }
+    return sum;
+}
+
+std::ostream &operator<<(std::ostream &out, const StartupTimes &times)
+{
+    out << "Startup: " << times.total().count() * 1000.0 << "ms to the first frame" << std::endl;
+    for (auto &stage : times.stages) {
+        out << "  " << stage.name << ": " << stage.duration.count() * 1000.0 << "ms" << std::endl;
+    }
+    return out;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Durations of the startup stages, up to the first presented frame
+ */
+struct StartupTimes
+{
+    struct Stage
+    {
+        std::string name;
+        std::chrono::duration<double> duration;
+    };
+
+    std::vector<Stage> stages;
+
+    StartupTimes();
+
+    // ends the current stage, the next one starts right away
+    void mark(std::string name);
+    std::chrono::duration<double> total() const;
+
+    friend std::ostream &operator<<(std::ostream &out, const StartupTimes &times);
+
+  private:
+    std::chrono::steady_clock::time_point m_lastTimeStamp;
+};
@@ -1,12 +1,15 @@
 #include "Status.hpp"
 
+#include <algorithm>
+
 Status::Status()
     : totalSumFrameDuration(0.0s), totalFrameCount(0), totalAvgFrameDuration(0.0s), totalFPS(0.0f),
       currentAvgFrameDuration(0.0s), currentFPS(0.0f),
       currentTimeStamp(std::chrono::steady_clock::now()), trackingSumFrameDuration(0.0s),
       trackingFrameCount(0), pipelineSumFrameDuration(0.0s), pipelineAvgFrameDuration(0.0s),
-      pipelineFrameCount(0),
-      pipelineFPS(0.0f)
+      pipelineFrameCount(0), pipelineFPS(0.0f), pipelineWarmingUp(true),
+      pipelineWarmupFrameCount(0), pipelineWarmupDuration(0.0s),
+      pipelineBuildDuration(0.0s), pipelineBuildCount(0)
 {}
 
 void Status::update(std::chrono::duration<float> lastFrameDuration)
@@ -17,42 +20,69 @@ void Status::update(std::chrono::duration<float> lastFrameDuration)
     totalFrameCount++;
     totalAvgFrameDuration = totalSumFrameDuration / totalFrameCount;
     totalFPS = 1.0f / totalAvgFrameDuration.count();
+    totalHistogram.add(lastFrameDuration);
 
     trackingSumFrameDuration += lastFrameDuration;
     trackingFrameCount++;
+    trackingHistogram.add(lastFrameDuration);
 
-    pipelineSumFrameDuration += lastFrameDuration;
-    pipelineFrameCount++;
-    pipelineAvgFrameDuration = pipelineSumFrameDuration / (double)pipelineFrameCount;
-    pipelineFPS = 1.0f / pipelineAvgFrameDuration.count();
+    if (pipelineWarmingUp && !isWarmupOver(lastFrameDuration)) {
+        pipelineWarmupFrameCount++;
+        pipelineWarmupDuration += lastFrameDuration;
+    } else {
+        pipelineWarmingUp = false;
+        pipelineSumFrameDuration += lastFrameDuration;
+        pipelineFrameCount++;
+        pipelineAvgFrameDuration = pipelineSumFrameDuration / (double)pipelineFrameCount;
+        pipelineFPS = 1.0f / pipelineAvgFrameDuration.count();
+        pipelineHistogram.add(lastFrameDuration);
+    }
 
     if (now - currentTimeStamp >= 1s) {
         currentAvgFrameDuration = trackingSumFrameDuration / trackingFrameCount;
         currentFPS = 1.0f / currentAvgFrameDuration.count();
+        currentPercentiles = FrameTimePercentiles(trackingHistogram);
         trackingSumFrameDuration = 0s;
         trackingFrameCount = 0;
+        trackingHistogram.reset();
         currentTimeStamp = now;
 
-        std::stringstream ss;
-        ss << "Current:" << std::endl;
-        MMeter::getThreadLocalTreePtr()->outputBranchPercentagesToOStream(ss);
-
-        aggregateTree.merge(*MMeter::getThreadLocalTreePtr());
-        MMeter::getThreadLocalTreePtr()->reset();
-
-        ss << "Total:" << std::endl
-           << aggregateTree;
+        totalPercentiles = FrameTimePercentiles(totalHistogram);
+        pipelinePercentiles = FrameTimePercentiles(pipelineHistogram);
 
-        ss << "Total flat:" << std::endl
-           << aggregateTree.totalsByDurationStr() << "\n\n\n"
-           << std::endl;
-
-        mmeterMetrics = ss.str();
+        profiler.submitThreadTree();
     }
 }
 
-void Status::resetPipeline() {
+void Status::collectProfilerData()
+{
+    profiler.flush();
+}
+
+void Status::resetPipeline(bool detectWarmup) {
     pipelineSumFrameDuration = 0s;
     pipelineFrameCount = 0;
-    aggregateTree.reset();
+    pipelineHistogram.reset();
+    pipelinePercentiles = FrameTimePercentiles();
+    pipelineWarmingUp = detectWarmup;
+    pipelineWarmupFrameCount = 0;
+    pipelineWarmupDuration = 0s;
+    profiler.reset();
+}
+
+bool Status::isWarmupOver(std::chrono::duration<double> lastFrameDuration)
+{
+    if (pipelineWarmupFrameCount >= MAX_WARMUP_FRAMES ||
+        pipelineWarmupDuration >= MAX_WARMUP_DURATION) {
+        return true;
+    }
+
+    m_warmupWindow[pipelineWarmupFrameCount % WARMUP_WINDOW_SIZE] = lastFrameDuration;
+    if (pipelineWarmupFrameCount + 1 < WARMUP_WINDOW_SIZE) {
+        return false;
+    }
+
+    // settled once the latest frames are within a factor of 1.5 of each other
+    auto [minIt, maxIt] = std::minmax_element(m_warmupWindow.begin(), m_warmupWindow.end());
+    return *maxIt <= *minIt * 1.5;
 }
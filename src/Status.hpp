@@ -1,6 +1,13 @@
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <memory>
+#include <string>
+
+#include "FrameTimeHistogram.hpp"
+#include "ProfilerAggregator.hpp"
+#include "StartupTimes.hpp"
 
 #include "MMeter.h"
 
@@ -12,25 +19,55 @@ struct Status
     std::size_t totalFrameCount;
     std::chrono::duration<double> totalAvgFrameDuration;
     float totalFPS;
+    FrameTimeHistogram totalHistogram;
+    FrameTimePercentiles totalPercentiles;
 
     std::chrono::duration<double> currentAvgFrameDuration;
     float currentFPS;
     std::chrono::steady_clock::time_point currentTimeStamp;
+    FrameTimePercentiles currentPercentiles;
 
     std::chrono::duration<double> trackingSumFrameDuration;
     std::size_t trackingFrameCount;
+    FrameTimeHistogram trackingHistogram;
 
     std::chrono::duration<double> pipelineSumFrameDuration;
     std::chrono::duration<double> pipelineAvgFrameDuration;
     std::size_t pipelineFrameCount;
     float pipelineFPS;
+    FrameTimeHistogram pipelineHistogram;
+    FrameTimePercentiles pipelinePercentiles;
+
+    // Frames right after a pipeline rebuild (shader compilation, resource uploads) are excluded
+    // from the pipeline stats until the frame durations settle
+    bool pipelineWarmingUp;
+    std::size_t pipelineWarmupFrameCount;
+    std::chrono::duration<double> pipelineWarmupDuration;
+
+    // duration of the latest background pipeline build
+    std::chrono::duration<double> pipelineBuildDuration;
+    std::size_t pipelineBuildCount;
+
+    StartupTimes startupTimes;
 
-    std::string mmeterMetrics;
-    MMeter::FuncProfilerTree aggregateTree;
+    // MMeter data of the current pipeline, merged on a background thread
+    ProfilerAggregator profiler;
 
     Status();
     ~Status() = default;
 
     void update(std::chrono::duration<float> lastFrameDuration);
-    void resetPipeline();
-};
\ No newline at end of file
+    // hands the calling thread's MMeter tree to the profiler and waits until it's aggregated
+    void collectProfilerData();
+    void resetPipeline(bool detectWarmup = true);
+
+  private:
+    static constexpr std::size_t WARMUP_WINDOW_SIZE = 8;
+    static constexpr std::size_t MAX_WARMUP_FRAMES = 300;
+    static constexpr std::chrono::duration<double> MAX_WARMUP_DURATION = 2s;
+
+    // durations of the latest warm-up frames, used to detect when they settle
+    std::array<std::chrono::duration<double>, WARMUP_WINDOW_SIZE> m_warmupWindow;
+
+    bool isWarmupOver(std::chrono::duration<double> lastFrameDuration);
+};
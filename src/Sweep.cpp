@@ -0,0 +1,244 @@
+#include "Sweep.hpp"
+
+#include "Benchmark.hpp"
+#include "Csv.hpp"
+#include "JsonWriter.hpp"
+
+#include "Vitrae/Collections/MethodCollection.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+namespace
+{
+const std::string OUTPUT_DIMENSION = "output";
+
+struct Dimension
+{
+    std::string name;
+    std::vector<std::string> options;
+};
+
+std::vector<Dimension> sweptDimensions(ComponentRoot &root, const Options &options)
+{
+    MethodCollection &methodCollection = root.getComponent<MethodCollection>();
+
+    std::vector<Dimension> dimensions;
+    Dimension &outputs = dimensions.emplace_back(Dimension{OUTPUT_DIMENSION, {}});
+    for (auto outputName : methodCollection.getCompositorOutputs()) {
+        outputs.options.push_back(outputName);
+    }
+    for (auto [target, methodOptions] : methodCollection.getPropertyOptionsMap()) {
+        dimensions.push_back(
+            Dimension{target, std::vector<std::string>(methodOptions.begin(), methodOptions.end())});
+    }
+
+    for (auto &[name, onlyOptions] : options.sweepFilters) {
+        auto it = std::find_if(dimensions.begin(), dimensions.end(),
+                               [&](const Dimension &dimension) { return dimension.name == name; });
+        if (it == dimensions.end()) {
+            throw std::invalid_argument("Cannot sweep unknown property " + name);
+        }
+        for (auto &option : onlyOptions) {
+            if (std::find(it->options.begin(), it->options.end(), option) == it->options.end()) {
+                throw std::invalid_argument("Unknown option " + option + " of " + name);
+            }
+        }
+        it->options = onlyOptions;
+    }
+
+    return dimensions;
+}
+
+void sumSelfDurations(const ProfileNode &node,
+                      std::map<std::string, std::chrono::duration<double>> &durations)
+{
+    for (auto &child : node.children) {
+        durations[child.name] += child.selfDuration;
+        sumSelfDurations(child, durations);
+    }
+}
+
+std::vector<SweepTable::Scope> topScopes(const ProfileNode &tree, std::size_t frameCount)
+{
+    std::map<std::string, std::chrono::duration<double>> durations;
+    sumSelfDurations(tree, durations);
+
+    std::vector<SweepTable::Scope> scopes;
+    for (auto &[name, duration] : durations) {
+        scopes.push_back(
+            SweepTable::Scope{name, duration / (double)std::max<std::size_t>(frameCount, 1)});
+    }
+    std::sort(scopes.begin(), scopes.end(), [](const auto &a, const auto &b) {
+        return a.durationPerFrame > b.durationPerFrame;
+    });
+    if (scopes.size() > SweepTable::TOP_SCOPE_COUNT) {
+        scopes.resize(SweepTable::TOP_SCOPE_COUNT);
+    }
+    return scopes;
+}
+} // namespace
+
+void SweepTable::writeJson(std::ostream &out) const
+{
+    JsonWriter json(out);
+
+    json.beginObject();
+    json.key("dimensions");
+    json.beginArray();
+    for (auto &dimension : dimensions) {
+        json.value(dimension);
+    }
+    json.endArray();
+
+    json.key("configurations");
+    json.beginArray();
+    for (auto &row : rows) {
+        json.beginObject();
+        json.key("choices");
+        json.beginObject();
+        for (auto &[dimension, option] : row.choices) {
+            json.field(dimension, option);
+        }
+        json.endObject();
+        json.field("built", row.built);
+        json.field("buildMs", row.buildDuration.count() * 1000.0);
+        json.field("frames", (std::uint64_t)row.frameCount);
+        json.field("meanMs", row.meanFrameDuration.count() * 1000.0);
+        json.field("p50Ms", row.percentiles.p50.count() * 1000.0);
+        json.field("p90Ms", row.percentiles.p90.count() * 1000.0);
+        json.field("p99Ms", row.percentiles.p99.count() * 1000.0);
+        json.field("p999Ms", row.percentiles.p999.count() * 1000.0);
+        json.field("maxMs", row.percentiles.max.count() * 1000.0);
+        json.key("topScopes");
+        json.beginArray();
+        for (auto &scope : row.topScopes) {
+            json.beginObject();
+            json.field("name", scope.name);
+            json.field("msPerFrame", scope.durationPerFrame.count() * 1000.0);
+            json.endObject();
+        }
+        json.endArray();
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+    out << std::endl;
+}
+
+void SweepTable::writeCsv(std::ostream &out) const
+{
+    for (auto &dimension : dimensions) {
+        out << csvField(dimension) << ",";
+    }
+    out << "built,build_ms,frames,mean_ms,p50_ms,p90_ms,p99_ms,p999_ms,max_ms,top_scopes"
+        << std::endl;
+
+    for (auto &row : rows) {
+        for (auto &dimension : dimensions) {
+            auto it = row.choices.find(dimension);
+            out << csvField(it != row.choices.end() ? it->second : "") << ",";
+        }
+
+        std::string scopes;
+        for (auto &scope : row.topScopes) {
+            if (!scopes.empty()) {
+                scopes += "; ";
+            }
+            scopes += scope.name + " " + std::to_string(scope.durationPerFrame.count() * 1000.0) +
+                      "ms";
+        }
+
+        out << (row.built ? "true" : "false") << "," << row.buildDuration.count() * 1000.0 << ","
+            << row.frameCount << "," << row.meanFrameDuration.count() * 1000.0 << ","
+            << row.percentiles.p50.count() * 1000.0 << ","
+            << row.percentiles.p90.count() * 1000.0 << ","
+            << row.percentiles.p99.count() * 1000.0 << ","
+            << row.percentiles.p999.count() * 1000.0 << ","
+            << row.percentiles.max.count() * 1000.0 << "," << csvField(scopes) << std::endl;
+    }
+}
+
+int runSweep(AssetCollection &collection, Status &status, const Options &options)
+{
+    std::vector<Dimension> dimensions;
+    try {
+        dimensions = sweptDimensions(collection.root, options);
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    SweepTable table;
+    std::size_t configCount = 1;
+    for (auto &dimension : dimensions) {
+        table.dimensions.push_back(dimension.name);
+        configCount *= dimension.options.size();
+    }
+
+    for (std::size_t configIndex = 0; configIndex < configCount; configIndex++) {
+        SweepTable::Row &row = table.rows.emplace_back();
+        PipelineConfig config;
+
+        // the last dimension changes fastest
+        std::size_t remainingIndex = configIndex;
+        for (std::size_t i = dimensions.size(); i-- > 0;) {
+            const Dimension &dimension = dimensions[i];
+            const std::string &option =
+                dimension.options[remainingIndex % dimension.options.size()];
+            remainingIndex /= dimension.options.size();
+
+            row.choices[dimension.name] = option;
+            if (dimension.name == OUTPUT_DIMENSION) {
+                config.desiredOutputs.insert_back(ParamSpec{
+                    .name = option,
+                    .typeInfo = TYPE_INFO<void>,
+                });
+            } else {
+                config.aliases[dimension.name] = option;
+            }
+        }
+
+        std::cerr << "Configuration " << configIndex + 1 << "/" << configCount << ":";
+        for (auto &[dimension, option] : row.choices) {
+            std::cerr << " " << dimension << "=" << option;
+        }
+        std::cerr << std::endl;
+
+        // every configuration is built from scratch, so build times are comparable
+        collection.pipelineCache.clear();
+        collection.pipelineConfig = config;
+        collection.shouldReloadPipelines = true;
+        std::size_t buildCount = status.pipelineBuildCount;
+        collection.waitForPipeline();
+
+        row.built = status.pipelineBuildCount != buildCount;
+        if (!row.built) {
+            std::cerr << "Skipped, the pipeline couldn't be built" << std::endl;
+            continue;
+        }
+        row.buildDuration = status.pipelineBuildDuration;
+
+        if (collection.cameraPathPlayer) {
+            collection.cameraPathPlayer->rewind();
+        }
+        measurePipeline(collection, status, options);
+
+        row.frameCount = status.pipelineFrameCount;
+        row.meanFrameDuration = status.pipelineHistogram.mean();
+        row.percentiles = FrameTimePercentiles(status.pipelineHistogram);
+        row.topScopes = topScopes(*status.profiler.getProfileTree(), row.frameCount);
+    }
+
+    bool asCsv = options.reportPath.extension() == ".csv";
+    bool written = writeToReportPath(options, [&](std::ostream &out) {
+        if (asCsv) {
+            table.writeCsv(out);
+        } else {
+            table.writeJson(out);
+        }
+    });
+    return written ? 0 : 1;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Options.hpp"
+#include "Status.hpp"
+#include "assetCollection.hpp"
+
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Results of benchmarking a set of pipeline configurations one after another
+ */
+struct SweepTable
+{
+    struct Scope
+    {
+        std::string name;
+        std::chrono::duration<double> durationPerFrame;
+    };
+
+    struct Row
+    {
+        // swept method property (or "output") -> chosen option
+        std::map<std::string, std::string> choices;
+        bool built = false;
+        std::chrono::duration<double> buildDuration{0.0};
+        std::size_t frameCount = 0;
+        std::chrono::duration<double> meanFrameDuration{0.0};
+        FrameTimePercentiles percentiles;
+        // scopes with the highest self time
+        std::vector<Scope> topScopes;
+    };
+
+    static constexpr std::size_t TOP_SCOPE_COUNT = 5;
+
+    // names of the swept dimensions, in column order
+    std::vector<std::string> dimensions;
+    std::vector<Row> rows;
+
+    void writeJson(std::ostream &out) const;
+    void writeCsv(std::ostream &out) const;
+};
+
+/**
+ * Benchmarks every combination of method options and compositor outputs
+ * (limited by options.sweepFilters) and writes the comparison table.
+ * @returns the process exit code
+ */
+int runSweep(AssetCollection &collection, Status &status, const Options &options);
@@ -0,0 +1,170 @@
+#include "Trace.hpp"
+
+#include "JsonWriter.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+TraceRecorder &TraceRecorder::instance()
+{
+    static TraceRecorder recorder;
+    return recorder;
+}
+
+TraceRecorder::TraceRecorder() : m_startTime(std::chrono::steady_clock::now()) {}
+
+void TraceRecorder::setThreadName(std::string name)
+{
+    ThreadBuffer &buffer = threadBuffer();
+    std::unique_lock lock(m_mutex);
+    buffer.name = std::move(name);
+}
+
+void TraceRecorder::record(const char *name, EventType type)
+{
+    ThreadBuffer &buffer = threadBuffer();
+    std::uint64_t index = buffer.writeCount.load(std::memory_order_relaxed);
+    // orders the previous count before the slot's fields, for copyEvents() to detect overwrites
+    std::atomic_thread_fence(std::memory_order_release);
+    EventSlot &slot = buffer.events[index % BUFFER_CAPACITY];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.time.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
+    slot.type.store(type, std::memory_order_relaxed);
+    buffer.writeCount.store(index + 1, std::memory_order_release);
+}
+
+void TraceRecorder::writeChromeJson(std::ostream &out,
+                                    std::chrono::duration<double> duration) const
+{
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::vector<std::string> threadNames;
+    {
+        std::unique_lock lock(m_mutex);
+        buffers = m_buffers;
+        for (auto &p_buffer : buffers) {
+            threadNames.push_back(p_buffer->name);
+        }
+    }
+    auto startTime = std::chrono::steady_clock::now() - duration;
+    auto microseconds = [&](std::chrono::steady_clock::time_point time) {
+        return std::chrono::duration<double, std::micro>(time - m_startTime).count();
+    };
+
+    JsonWriter json(out);
+    json.beginObject();
+    json.field("displayTimeUnit", "ms");
+    json.key("traceEvents");
+    json.beginArray();
+
+    for (std::size_t i = 0; i < buffers.size(); i++) {
+        std::uint32_t threadIndex = buffers[i]->threadIndex;
+
+        json.beginObject();
+        json.field("name", "thread_name");
+        json.field("ph", "M");
+        json.field("pid", (std::uint32_t)1);
+        json.field("tid", threadIndex);
+        json.key("args");
+        json.beginObject();
+        json.field("name", threadNames[i].empty() ? "Thread " + std::to_string(threadIndex)
+                                                  : threadNames[i]);
+        json.endObject();
+        json.endObject();
+
+        // ends of scopes that began before the written events are left out
+        std::size_t depth = 0;
+        for (auto &event : copyEvents(*buffers[i])) {
+            if (event.time < startTime) {
+                continue;
+            }
+            if (event.type == EventType::End) {
+                if (depth == 0) {
+                    continue;
+                }
+                depth--;
+            } else if (event.type == EventType::Begin) {
+                depth++;
+            }
+
+            json.beginObject();
+            json.field("name", event.name);
+            json.field("ph", event.type == EventType::Begin ? "B"
+                             : event.type == EventType::End ? "E"
+                                                            : "i");
+            if (event.type == EventType::Instant) {
+                json.field("s", "t");
+            }
+            json.field("ts", microseconds(event.time));
+            json.field("pid", (std::uint32_t)1);
+            json.field("tid", threadIndex);
+            json.endObject();
+        }
+    }
+
+    json.endArray();
+    json.endObject();
+    out << std::endl;
+}
+
+TraceRecorder::ThreadBuffer &TraceRecorder::threadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> p_buffer;
+    if (!p_buffer) {
+        p_buffer = std::make_shared<ThreadBuffer>();
+        std::unique_lock lock(m_mutex);
+        p_buffer->threadIndex = (std::uint32_t)m_buffers.size();
+        m_buffers.push_back(p_buffer);
+    }
+    return *p_buffer;
+}
+
+std::vector<TraceRecorder::Event> TraceRecorder::copyEvents(const ThreadBuffer &buffer)
+{
+    std::uint64_t endIndex = buffer.writeCount.load(std::memory_order_acquire);
+    std::uint64_t beginIndex = endIndex > BUFFER_CAPACITY ? endIndex - BUFFER_CAPACITY : 0;
+
+    std::vector<Event> events;
+    events.reserve(endIndex - beginIndex);
+    for (std::uint64_t i = beginIndex; i < endIndex; i++) {
+        const EventSlot &slot = buffer.events[i % BUFFER_CAPACITY];
+        events.push_back(Event{
+            .name = slot.name.load(std::memory_order_relaxed),
+            .time = slot.time.load(std::memory_order_relaxed),
+            .type = slot.type.load(std::memory_order_relaxed),
+        });
+    }
+
+    // the owning thread kept writing meanwhile, including into the slot after the last count;
+    // pairs with the fence in record(), so the count covers every overwrite seen above
+    std::atomic_thread_fence(std::memory_order_acquire);
+    std::uint64_t writtenIndex = buffer.writeCount.load(std::memory_order_relaxed) + 1;
+    if (writtenIndex > beginIndex + BUFFER_CAPACITY) {
+        std::uint64_t overwrittenCount =
+            std::min<std::uint64_t>(writtenIndex - beginIndex - BUFFER_CAPACITY, events.size());
+        events.erase(events.begin(), events.begin() + overwrittenCount);
+    }
+    return events;
+}
+
+std::unique_lock<std::mutex> lockTraced(std::mutex &mutex, const char *waitName)
+{
+    std::unique_lock lock(mutex, std::try_to_lock);
+    if (!lock) {
+        TraceScope scope(waitName);
+        lock.lock();
+    }
+    return lock;
+}
+
+bool writeTraceFile(const std::filesystem::path &path, std::chrono::duration<double> duration)
+{
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Can't write the trace to " << path << std::endl;
+        return false;
+    }
+    TraceRecorder::instance().writeChromeJson(file, duration);
+    std::cerr << "Trace written to " << path << std::endl;
+    return true;
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "MMeter.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * Records timestamped scope and marker events of all threads, for viewing individual frames
+ * on a timeline. Each thread writes into its own ring buffer without locking,
+ * so recording stays cheap enough to leave on; only the latest events are kept
+ */
+class TraceRecorder
+{
+  public:
+    // events kept per thread
+    static constexpr std::size_t BUFFER_CAPACITY = 1 << 16;
+
+    enum class EventType : std::uint8_t
+    {
+        Begin,
+        End,
+        Instant
+    };
+
+    static TraceRecorder &instance();
+
+    // names the calling thread in the trace
+    void setThreadName(std::string name);
+
+    // the name must outlive the recorder, e.g. a string literal
+    void record(const char *name, EventType type);
+
+    // writes the events of the latest duration in the Chrome trace JSON format
+    void writeChromeJson(std::ostream &out, std::chrono::duration<double> duration) const;
+
+  private:
+    struct Event
+    {
+        const char *name;
+        std::chrono::steady_clock::time_point time;
+        EventType type;
+    };
+
+    // an Event that can be copied while its thread overwrites it; torn copies are detected
+    // by reading writeCount after the fields, like a sequence lock
+    struct EventSlot
+    {
+        std::atomic<const char *> name;
+        std::atomic<std::chrono::steady_clock::time_point> time;
+        std::atomic<EventType> type;
+    };
+
+    struct ThreadBuffer
+    {
+        std::uint32_t threadIndex;
+        std::string name;
+        std::array<EventSlot, BUFFER_CAPACITY> events;
+        // the events are written in order, so this is also the index of the next event
+        std::atomic<std::uint64_t> writeCount = 0;
+    };
+
+    std::chrono::steady_clock::time_point m_startTime;
+    mutable std::mutex m_mutex;
+    // kept after their threads end, until the program exits
+    std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+
+    TraceRecorder();
+
+    ThreadBuffer &threadBuffer();
+    // copies the events that weren't overwritten while copying
+    static std::vector<Event> copyEvents(const ThreadBuffer &buffer);
+};
+
+/**
+ * Records the begin and end of its lifetime in the trace
+ */
+class TraceScope
+{
+  public:
+    TraceScope(const char *name) : m_name(name)
+    {
+        TraceRecorder::instance().record(name, TraceRecorder::EventType::Begin);
+    }
+    ~TraceScope() { TraceRecorder::instance().record(m_name, TraceRecorder::EventType::End); }
+
+  private:
+    const char *m_name;
+};
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+// measures the scope with MMeter and records it in the trace
+#define PROFILE_SCOPE(name)                                                                        \
+    MMETER_SCOPE_PROFILER(name);                                                                   \
+    TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+
+// locks the mutex, recording the time spent waiting for it in the trace
+std::unique_lock<std::mutex> lockTraced(std::mutex &mutex, const char *waitName);
+
+// writes the trace of the latest duration to the file; @returns whether it succeeded
+bool writeTraceFile(const std::filesystem::path &path, std::chrono::duration<double> duration);
@@ -3,7 +3,9 @@
 #include "Vitrae/Assets/Compositor.hpp"
 #include "Vitrae/Assets/FrameStore.hpp"
 #include "Vitrae/Assets/Scene.hpp"
+#include "Vitrae/Assets/Texture.hpp"
 #include "Vitrae/Collections/ComponentRoot.hpp"
+#include "Vitrae/Collections/MethodCollection.hpp"
 #include "Vitrae/Data/LevelOfDetail.hpp"
 #include "Vitrae/Params/Standard.hpp"
 #include "Vitrae/Pipelines/Compositing/ClearRender.hpp"
@@ -16,110 +18,641 @@
 #include "dynasma/keepers/naive.hpp"
 #include "dynasma/standalone.hpp"
 
-#include "MMeter.h"
+#include "Trace.hpp"
 
 #include "glm/gtx/vector_angle.hpp"
 
-AssetCollection::AssetCollection(ComponentRoot &root, Renderer &rend,
-                                 std::filesystem::path scenePath, float sceneScale)
-    : root(root), rend(rend), running(true), shouldReloadPipelines(true), compositorInputsHash(0),
-      comp(root)
+#include <thread>
+
+AssetCollection::AssetCollection(ComponentRoot &root, Renderer &rend, Status &status,
+                                 const Options &options)
+    : root(root), rend(rend), status(status), running(true), shouldReloadPipelines(true),
+      p_comp(std::make_unique<Compositor>(root)), pipelineBuilder(root, engineMutex),
+      pipelineCache(options.pipelineCacheSize), memoryBudget(options.memoryBudget * 1024 * 1024),
+      lodController(std::chrono::duration<double>(options.lodTarget / 1000.0)),
+      framePacer(options.vsync                  ? FramePacer::Mode::VSync
+                 : options.frameRateLimit > 0.0 ? FramePacer::Mode::FixedRate
+                                                : FramePacer::Mode::Uncapped,
+                 options.frameRateLimit > 0.0 ? options.frameRateLimit
+                                              : FramePacer::DEFAULT_TARGET_RATE),
+      queuedCommandCount(0), appliedCommandCount(0), publishedFrameCount(0),
+      m_options(options), m_hasPipeline(false), m_shouldCleanMemoryPools(false),
+      m_activeBuildDuration(0.0), m_activeCacheable(false)
 {
     /*
     Setup window
     */
     running = true;
 
-    p_windowFrame =
-        root.getComponent<FrameStoreManager>()
-            .register_asset(FrameStoreSeed{FrameStore::WindowDisplayParams{
-                .root = root,
-                .width = 800,
-                .height = 600,
-                .title = "Vitrae Showcase",
-                .isFullscreen = false,
-                .clearColor = glm::vec4{0.0f, 0.75f, 1.0f, 1.0f},
-                .onClose = [&]() { running = false; },
-                .onDrag =
-                    [&](glm::vec2 motion, bool bLeft, bool bRight, bool bMiddle) {
-                        // Camera rotation
-                        if (bRight) {
-                            glm::vec3 dirVec =
-                                p_scene->camera.rotation * glm::vec3{0.0f, 0.0f, 1.0f};
-                            float yaw = glm::orientedAngle(
-                                glm::normalize(glm::vec2{dirVec.x, dirVec.z}), {0.0, 1.0});
-                            float pitch = glm::orientedAngle(
-                                glm::normalize(
-                                    glm::vec2{glm::sqrt(dirVec.x * dirVec.x + dirVec.z * dirVec.z),
-                                              dirVec.y}),
-                                {1.0, 0.0});
-                            yaw += 0.15f * glm::radians(motion.x);
-                            pitch += 0.15f * glm::radians(motion.y);
-                            p_scene->camera.rotation = glm::quat(glm::vec3(pitch, yaw, 0.0f));
-                        }
-
-                        // Camera movement
-                        if (bLeft) {
-                            p_scene->camera.move(p_scene->camera.rotation *
-                                                 (0.02f * glm::vec3{-motion.x, 0.0, -motion.y}));
-                        }
-
-                        // Scene scaling (in case of wrong scale)
-                        if (bMiddle) {
-                            p_scene->camera.move(p_scene->camera.rotation *
-                                                 (0.02f * glm::vec3{-motion.x, motion.y, 0.0}));
-                        }
-                    }}})
-            .getLoaded();
+    if (options.headless) {
+        OffscreenFrame offscreenFrame = createOffscreenFrame(
+            glm::uvec2(options.frameWidth, options.frameHeight), "Headless frame");
+        p_displayFrame = offscreenFrame.p_frame;
+        p_displayColorTexture = offscreenFrame.p_colorTexture;
+    } else {
+        p_displayFrame =
+            root.getComponent<FrameStoreManager>()
+                .register_asset(FrameStoreSeed{FrameStore::WindowDisplayParams{
+                    .root = root,
+                    .width = 800,
+                    .height = 600,
+                    .title = "Vitrae Showcase",
+                    .isFullscreen = false,
+                    .clearColor = glm::vec4{0.0f, 0.75f, 1.0f, 1.0f},
+                    .onClose = [&]() { running = false; },
+                    .onDrag =
+                        [&](glm::vec2 motion, bool bLeft, bool bRight, bool bMiddle) {
+                            queueDrag(motion, bLeft, bRight, bMiddle);
+                        }}})
+                .getLoaded();
+    }
+
+    p_renderFrame = p_displayFrame;
+    if (options.resolutionTarget > 0.0) {
+        resolutionController.emplace(
+            std::chrono::duration<double>(options.resolutionTarget / 1000.0),
+            (float)options.minResolutionScale, (float)options.maxResolutionScale);
+    }
 
     /*
-    Setup assets
+    Camera paths; the played one is loaded along with the scene, where errors are handled
     */
-
-    p_scene =
-        dynasma::makeStandalone<Scene>(Scene::FileLoadParams{.root = root, .filepath = scenePath});
-    p_scene->camera.position = glm::vec3(-15.0, 10.0, 1.3);
-    p_scene->camera.scaling = glm::vec3(1, 1, 1);
-    p_scene->camera.zNear = 0.05f;
-    p_scene->camera.zFar = 1000.0f;
-    p_scene->camera.rotation = glm::quatLookAt(glm::vec3(0.8, -0.5, 0), glm::vec3(0, 1, 0));
-    for (auto &prop : p_scene->modelProps)
-    {
-        prop.transform.position = prop.transform.position * sceneScale;
-        prop.transform.scale(glm::vec3(sceneScale));
+    if (!options.recordCameraPathPath.empty()) {
+        cameraPathRecorder.emplace(options.recordInterval);
     }
 
     /*
     Compositor
     */
-    comp.parameters.set("scene", p_scene);
-    comp.parameters.set("fs_display", p_windowFrame);
-    comp.parameters.set("vsync", false);
-    comp.parameters.set(StandardParam::LoDParams.name, LoDSelectionParams{
-                                                           .method = LoDSelectionMethod::FirstBelowThreshold,
-                                                           .threshold = {.minElementSize = 2},
-                                                       });
+    p_comp->parameters.set("fs_display", p_renderFrame);
+    p_comp->parameters.set("vsync", framePacer.getMode() == FramePacer::Mode::VSync);
+    p_comp->parameters.set(StandardParam::LoDParams.name, lodController.getParams());
+
+    // Default to the first output and the first option of every method,
+    // until the GUI says otherwise
+    MethodCollection &methodCollection = root.getComponent<MethodCollection>();
+    for (auto outputName : methodCollection.getCompositorOutputs()) {
+        pipelineConfig.desiredOutputs.insert_back(ParamSpec{
+            .name = outputName,
+            .typeInfo = TYPE_INFO<void>,
+        });
+        break;
+    }
+    for (auto [target, methodOptions] : methodCollection.getPropertyOptionsMap()) {
+        pipelineConfig.aliases[target] = methodOptions[0];
+    }
+
+    // they're built along with each main pipeline
+    comparisonViews.reserve(options.comparisons.size());
+    for (auto &overrides : options.comparisons) {
+        comparisonViews.emplace_back(root, engineMutex, overrides);
+    }
 }
 
 AssetCollection::~AssetCollection() {}
 
+void AssetCollection::loadScene()
+{
+    if (!m_options.cameraPathPath.empty()) {
+        cameraPathPlayer.emplace(CameraPath::load(m_options.cameraPathPath), !m_options.headless);
+    }
+
+    SceneLoader::CacheMode cacheMode = !m_options.useSceneCache ? SceneLoader::CacheMode::Ignore
+                                       : m_options.bakeScene    ? SceneLoader::CacheMode::Bake
+                                                                : SceneLoader::CacheMode::Use;
+    auto p_loadedScene = sceneLoader.load(root, m_options.scenePath, m_options.sceneScale,
+                                          cacheMode, m_options.amplification);
+
+    p_loadedScene->camera.position = glm::vec3(-15.0, 10.0, 1.3);
+    p_loadedScene->camera.scaling = glm::vec3(1, 1, 1);
+    p_loadedScene->camera.zNear = 0.05f;
+    p_loadedScene->camera.zFar = 1000.0f;
+    p_loadedScene->camera.rotation =
+        glm::quatLookAt(glm::vec3(0.8, -0.5, 0), glm::vec3(0, 1, 0));
+    if (cameraPathPlayer) {
+        cameraPathPlayer->apply(p_loadedScene->camera);
+    }
+    if (m_options.frustumCulling) {
+        frustumCuller.emplace(*p_loadedScene);
+    }
+    if (m_options.occlusionCulling) {
+        occlusionCuller.emplace();
+    }
+
+    p_scene = p_loadedScene;
+    setSharedParameter("scene", p_scene);
+}
+
+void AssetCollection::setFramePacing(FramePacer::Mode mode, double targetRate)
+{
+    framePacer.setMode(mode, targetRate);
+    setSharedParameter("vsync", mode == FramePacer::Mode::VSync);
+}
+
+void AssetCollection::queueDrag(glm::vec2 motion, bool bLeft, bool bRight, bool bMiddle)
+{
+    InputLatencyTracker::Stamp stamp = inputLatencyTracker.stamp();
+    queueCommand([=](AssetCollection &collection) {
+        collection.inputLatencyTracker.inputApplied(stamp);
+        collection.dragCamera(motion, bLeft, bRight, bMiddle);
+    });
+}
+
+void AssetCollection::dragCamera(glm::vec2 motion, bool bLeft, bool bRight, bool bMiddle)
+{
+    // Camera rotation
+    if (bRight) {
+        glm::vec3 dirVec = p_scene->camera.rotation * glm::vec3{0.0f, 0.0f, 1.0f};
+        float yaw =
+            glm::orientedAngle(glm::normalize(glm::vec2{dirVec.x, dirVec.z}), {0.0, 1.0});
+        float pitch = glm::orientedAngle(
+            glm::normalize(
+                glm::vec2{glm::sqrt(dirVec.x * dirVec.x + dirVec.z * dirVec.z), dirVec.y}),
+            {1.0, 0.0});
+        yaw += 0.15f * glm::radians(motion.x);
+        pitch += 0.15f * glm::radians(motion.y);
+        p_scene->camera.rotation = glm::quat(glm::vec3(pitch, yaw, 0.0f));
+    }
+
+    // Camera movement
+    if (bLeft) {
+        p_scene->camera.move(p_scene->camera.rotation *
+                             (0.02f * glm::vec3{-motion.x, 0.0, -motion.y}));
+    }
+
+    // Scene scaling (in case of wrong scale)
+    if (bMiddle) {
+        p_scene->camera.move(p_scene->camera.rotation *
+                             (0.02f * glm::vec3{-motion.x, motion.y, 0.0}));
+    }
+}
+
+std::size_t AssetCollection::propCount() const
+{
+    return frustumCuller ? frustumCuller->propCount() : p_scene->modelProps.size();
+}
+
 void AssetCollection::render()
 {
+    TraceRecorder::instance().record("Frame", TraceRecorder::EventType::Instant);
+    gpuProfiler.beginFrame();
+    inputLatencyTracker.beginFrame();
+    if (!m_hasPipeline) {
+        // nothing to show until the first pipeline is ready
+        waitForPipeline();
+    }
+
+    auto engineLock = lockTraced(engineMutex, "Wait for pipeline build");
+    applyCommands();
+
+    if (cameraPathPlayer) {
+        cameraPathPlayer->apply(p_scene->camera);
+    }
+
     if (shouldReloadPipelines) {
-        comp.rebuildPipeline();
+        requestPipeline();
+    }
+    if (auto result = pipelineBuilder.takeResult(); result) {
+        swapPipeline(std::move(*result), false);
+    }
+    for (auto &view : comparisonViews) {
+        if (auto result = view.p_builder->takeResult(); result) {
+            swapComparisonPipeline(view, std::move(*result));
+        }
+    }
+
+    if (rendersOffscreen()) {
+        updateRenderFrame();
+    }
+
+    if (frustumCuller) {
+        // the viewport's aspect can differ from the display's
+        glm::mat4 viewProjection = cameraViewProjection(p_scene->camera, p_renderFrame->getSize());
+        frustumCuller->cull(*p_scene, Frustum(viewProjection));
+        if (occlusionCuller) {
+            occlusionCuller->cull(*p_scene, viewProjection);
+        }
+    }
+
+    {
+        PROFILE_SCOPE("Compose");
+        GpuProfiler::Scope gpuScope(gpuProfiler, "Compose");
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        primitiveCounter.begin();
+        try {
+            p_comp->compose();
+        }
+        catch (const std::exception &e) {
+            std::cerr << e.what() << std::endl;
+        }
+        primitiveCounter.end();
+        composeHistogram.add(std::chrono::high_resolution_clock::now() - startTime);
+    }
+    if (!comparisonViews.empty()) {
+        composeComparisonViews();
+    }
+
+    if (rendersOffscreen()) {
+        presentRenderFrame();
+    }
+    inputLatencyTracker.endFrame();
+    updateInputSettings();
+
+    // the new pipeline holds on to what it needs after its first frame
+    if (m_shouldCleanMemoryPools) {
+        m_shouldCleanMemoryPools = false;
+        if (!memoryBudget.hasBudget()) {
+            memoryBudget.freeUnused(root);
+        }
+    }
+    memoryBudget.update(root);
+
+    engineLock.unlock();
+    pipelineBuilder.yieldEngine();
+    for (auto &view : comparisonViews) {
+        view.p_builder->yieldEngine();
+    }
+}
+
+void AssetCollection::updateRenderFrame()
+{
+    glm::uvec2 viewportSize =
+        glm::uvec2(p_displayFrame->getSize()) / glm::uvec2(viewportCount(), 1);
+    float scale = resolutionController ? resolutionController->getScale() : 1.0f;
+    glm::uvec2 size = glm::max(glm::uvec2(glm::vec2(viewportSize) * scale), glm::uvec2(1));
+    if (p_renderFrame != p_displayFrame && glm::uvec2(p_renderFrame->getSize()) == size) {
+        return;
+    }
+
+    OffscreenFrame renderFrame = createOffscreenFrame(size, "Scaled frame");
+    p_renderFrame = renderFrame.p_frame;
+    p_renderColorTexture = renderFrame.p_colorTexture;
+    p_comp->parameters.set("fs_display", p_renderFrame);
+}
+
+void AssetCollection::presentRenderFrame()
+{
+    PROFILE_SCOPE("Upscaling");
+    GpuProfiler::Scope gpuScope(gpuProfiler, "Upscaling");
+
+    if (p_displayColorTexture) {
+        // the comparison views keep their own frames
+        frameBlitter.blitToTexture(*p_renderColorTexture, *p_displayColorTexture);
+    } else {
+        glm::uvec2 viewportSize =
+            glm::uvec2(p_displayFrame->getSize()) / glm::uvec2(viewportCount(), 1);
+        if (!comparisonViews.empty()) {
+            // views that aren't built yet would show whatever was there
+            frameBlitter.clearWindow(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+        }
+        frameBlitter.blitToWindow(*p_renderColorTexture, glm::uvec2(0), viewportSize);
+        for (std::size_t i = 0; i < comparisonViews.size(); i++) {
+            const ComparisonView &view = comparisonViews[i];
+            if (view.p_colorTexture) {
+                frameBlitter.blitToWindow(*view.p_colorTexture,
+                                          glm::uvec2(viewportSize.x * (i + 1), 0), viewportSize);
+            }
+        }
+        // the compositor only presented the offscreen frame, so this present paces vsync
+        p_displayFrame->sync(framePacer.getMode() == FramePacer::Mode::VSync);
+    }
+}
+
+std::size_t AssetCollection::viewportCount() const
+{
+    // headless, the display frame only shows the main pipeline
+    return p_displayColorTexture ? 1 : comparisonViews.size() + 1;
+}
+
+bool AssetCollection::rendersOffscreen() const
+{
+    return resolutionController || viewportCount() > 1;
+}
+
+void AssetCollection::composeComparisonViews()
+{
+    PROFILE_SCOPE("Compose comparisons");
+
+    glm::uvec2 size = p_renderFrame->getSize();
+    for (auto &view : comparisonViews) {
+        if (!view.p_comp) {
+            continue;
+        }
+        if (!view.p_frame || glm::uvec2(view.p_frame->getSize()) != size) {
+            OffscreenFrame frame = createOffscreenFrame(size, "Comparison frame");
+            view.p_frame = frame.p_frame;
+            view.p_colorTexture = frame.p_colorTexture;
+            view.p_comp->parameters.set("fs_display", view.p_frame);
+        }
+
+        GpuProfiler::Scope gpuScope(gpuProfiler, view.name.c_str());
+        auto startTime = std::chrono::high_resolution_clock::now();
+        try {
+            view.p_comp->compose();
+        }
+        catch (const std::exception &e) {
+            std::cerr << e.what() << std::endl;
+        }
+        view.composeHistogram.add(std::chrono::high_resolution_clock::now() - startTime);
     }
+}
+
+void AssetCollection::swapComparisonPipeline(ComparisonView &view,
+                                             PipelineBuilder::Result pipeline)
+{
+    PROFILE_SCOPE("Pipeline swap");
 
-    try {
-        comp.compose();
+    // shared parameters are kept in sync by setSharedParameter()
+    pipeline.p_compositor->parameters = p_comp->parameters;
+    if (view.p_frame) {
+        pipeline.p_compositor->parameters.set("fs_display", view.p_frame);
     }
-    catch (const std::exception &e) {
-        std::cout << e.what() << std::endl;
+    std::swap(view.p_comp, pipeline.p_compositor);
+    std::swap(view.config, pipeline.config);
+    std::swap(view.buildDuration, pipeline.buildDuration);
+    view.composeHistogram.reset();
+
+    // the pipeline now holds the previous one; views share the cache with the main pipeline
+    if (pipeline.p_compositor && view.cacheable) {
+        pipelineCache.store(std::move(pipeline));
     }
-    compositorInputsHash = comp.getInputSpecs().getHash();
+    view.cacheable = true;
+}
 
-    if (shouldReloadPipelines)
+void AssetCollection::waitForPipeline()
+{
+    // the GUI queues its initial configuration, which would otherwise be built second
     {
-        shouldReloadPipelines = false;
-        root.cleanMemoryPools(std::numeric_limits<std::size_t>::max()); // free all possible memory
+        auto engineLock = lockTraced(engineMutex, "Wait for pipeline build");
+        applyCommands();
+        if (shouldReloadPipelines) {
+            requestPipeline();
+        }
+    }
+
+    pipelineBuilder.waitUntilIdle();
+    for (auto &view : comparisonViews) {
+        view.p_builder->waitUntilIdle();
+    }
+
+    auto engineLock = lockTraced(engineMutex, "Wait for pipeline build");
+    if (auto result = pipelineBuilder.takeResult(); result) {
+        swapPipeline(std::move(*result), false);
+    }
+    for (auto &view : comparisonViews) {
+        if (auto result = view.p_builder->takeResult(); result) {
+            swapComparisonPipeline(view, std::move(*result));
+        }
+    }
+}
+
+void AssetCollection::invalidatePipeline()
+{
+    shouldReloadPipelines = true;
+    m_activeCacheable = false;
+    for (auto &view : comparisonViews) {
+        view.cacheable = false;
+    }
+}
+
+void AssetCollection::requestPipeline()
+{
+    shouldReloadPipelines = false;
+
+    if (auto cached = pipelineCache.take(pipelineConfig); cached) {
+        // an older build would replace the cached pipeline when done
+        pipelineBuilder.cancel();
+        swapPipeline(std::move(*cached), true);
+    } else {
+        pipelineBuilder.request(pipelineConfig, p_comp->parameters);
+    }
+}
+
+void AssetCollection::updateInputSettings()
+{
+    std::size_t specsHash = p_comp->getInputSpecs().getHash();
+    if (mp_inputSettings && mp_inputSettings->specsHash == specsHash) {
+        return;
+    }
+
+    auto p_settings = std::make_shared<InputSettings>();
+    p_settings->specsHash = specsHash;
+    for (auto &spec : p_comp->getInputSpecs().getSpecList()) {
+        auto vp = p_comp->parameters.getPtr(spec.name);
+        // unset integers default to 1, since they are often sizes or counts
+        InputSetting setting{.name = spec.name, .isSet = vp != nullptr};
+        if (spec.typeInfo == TYPE_INFO<float>) {
+            setting.value = vp ? vp->get<float>() : 0.0f;
+        } else if (spec.typeInfo == TYPE_INFO<double>) {
+            setting.value = vp ? vp->get<double>() : 0.0;
+        } else if (spec.typeInfo == TYPE_INFO<bool>) {
+            setting.value = vp ? vp->get<bool>() : false;
+        } else if (spec.typeInfo == TYPE_INFO<std::int32_t>) {
+            setting.value = vp ? vp->get<std::int32_t>() : std::int32_t(1);
+        } else if (spec.typeInfo == TYPE_INFO<std::uint32_t>) {
+            setting.value = vp ? vp->get<std::uint32_t>() : std::uint32_t(1);
+        } else if (spec.typeInfo == TYPE_INFO<std::size_t>) {
+            setting.value = vp ? vp->get<std::size_t>() : std::size_t(1);
+        } else if (spec.typeInfo == TYPE_INFO<glm::uvec2>) {
+            setting.value = vp ? vp->get<glm::uvec2>() : glm::uvec2(1, 1);
+        } else {
+            continue;
+        }
+        p_settings->inputs.push_back(std::move(setting));
+    }
+    mp_inputSettings = std::move(p_settings);
+}
+
+void AssetCollection::swapPipeline(PipelineBuilder::Result pipeline, bool fromCache)
+{
+    PROFILE_SCOPE("Pipeline swap");
+
+    // parameters might have changed since the pipeline was last used
+    pipeline.p_compositor->parameters = p_comp->parameters;
+    std::swap(p_comp, pipeline.p_compositor);
+    std::swap(m_activeConfig, pipeline.config);
+    std::swap(m_activeBuildDuration, pipeline.buildDuration);
+
+    // the pipeline now holds the previous one
+    if (m_hasPipeline && m_activeCacheable) {
+        pipelineCache.store(std::move(pipeline));
     }
+    m_activeCacheable = true;
+    m_hasPipeline = true;
+    m_shouldCleanMemoryPools = true;
+
+    // the views differ from the main pipeline by their overrides only,
+    // so a cached main pipeline usually has its views cached too
+    for (auto &view : comparisonViews) {
+        PipelineConfig viewConfig = view.applyTo(m_activeConfig);
+        if (auto cached = pipelineCache.take(viewConfig); cached) {
+            view.p_builder->cancel();
+            swapComparisonPipeline(view, std::move(*cached));
+        } else {
+            view.p_builder->request(viewConfig, p_comp->parameters);
+        }
+    }
+
+    status.resetPipeline();
+    gpuProfiler.reset();
+    framePacer.reset();
+    inputLatencyTracker.reset();
+    composeHistogram.reset();
+    if (!fromCache) {
+        status.pipelineBuildDuration = m_activeBuildDuration;
+        status.pipelineBuildCount++;
+    }
+}
+
+void AssetCollection::queueCommand(Command command)
+{
+    // the queue is only full if the render thread is stuck; wait for it rather than drop input
+    while (!commands.tryPush(std::move(command))) {
+        std::this_thread::yield();
+    }
+    queuedCommandCount++;
+}
+
+void AssetCollection::applyCommands()
+{
+    PROFILE_SCOPE("Apply commands");
+
+    Command command;
+    while (commands.tryPop(command)) {
+        command(*this);
+        appliedCommandCount.fetch_add(1, std::memory_order_release);
+    }
+}
+
+bool AssetCollection::hasPendingCommands() const
+{
+    return appliedCommandCount.load(std::memory_order_acquire) != queuedCommandCount;
+}
+
+void AssetCollection::publishSnapshot(const Status &status)
+{
+    FrameSnapshot &snapshot = snapshots.writeBuffer();
+
+    snapshot.frameNumber = publishedFrameCount++;
+
+    snapshot.totalAvgFrameDuration = status.totalAvgFrameDuration;
+    snapshot.totalFPS = status.totalFPS;
+    snapshot.totalPercentiles = status.totalPercentiles;
+    snapshot.currentAvgFrameDuration = status.currentAvgFrameDuration;
+    snapshot.currentFPS = status.currentFPS;
+    snapshot.currentPercentiles = status.currentPercentiles;
+    snapshot.pipelineAvgFrameDuration = status.pipelineAvgFrameDuration;
+    snapshot.pipelineFPS = status.pipelineFPS;
+    snapshot.pipelinePercentiles = status.pipelinePercentiles;
+    snapshot.pipelineWarmingUp = status.pipelineWarmingUp;
+    snapshot.pipelineWarmupFrameCount = status.pipelineWarmupFrameCount;
+    snapshot.pipelineWarmupDuration = status.pipelineWarmupDuration;
+    snapshot.pipelineBuildDuration = status.pipelineBuildDuration;
+    snapshot.pipelineBuildCount = status.pipelineBuildCount;
+    snapshot.pipelineBuilding = pipelineBuilder.isBusy();
+    snapshot.pipelineCacheStats = pipelineCache.getStats();
+    snapshot.memoryStats = memoryBudget.getStats();
+    if (frustumCuller) {
+        snapshot.cullingStats = frustumCuller->getStats();
+    }
+    if (occlusionCuller) {
+        snapshot.occlusionStats = occlusionCuller->getStats();
+    }
+    snapshot.lodThreshold = lodController.getThreshold();
+    snapshot.primitiveCount = primitiveCounter.getLastCount();
+    if (resolutionController) {
+        snapshot.resolutionScale = resolutionController->getScale();
+        snapshot.resolutionSampleCount = resolutionController->getSampleCount();
+        snapshot.renderSize = p_renderFrame->getSize();
+    }
+    snapshot.pacingMode = framePacer.getMode();
+    snapshot.pacingTargetRate = framePacer.getTargetRate();
+    snapshot.pacingStats = framePacer.getStats();
+    snapshot.inputLatencyStats = inputLatencyTracker.getStats();
+    if (!comparisonViews.empty()) {
+        snapshot.composeTimings.resize(comparisonViews.size() + 1);
+        snapshot.composeTimings[0].name = "main";
+        snapshot.composeTimings[0].built = true;
+        snapshot.composeTimings[0].meanDuration = composeHistogram.mean();
+        for (std::size_t i = 0; i < comparisonViews.size(); i++) {
+            ComposeTiming &timing = snapshot.composeTimings[i + 1];
+            timing.name = comparisonViews[i].name;
+            timing.built = comparisonViews[i].p_comp != nullptr;
+            timing.meanDuration = comparisonViews[i].composeHistogram.mean();
+        }
+    }
+    snapshot.p_profileTree = status.profiler.getProfileTree();
+    snapshot.p_gpuTimes = gpuProfiler.getTimes();
+    snapshot.p_inputSettings = mp_inputSettings;
+
+    snapshot.cameraPosition = p_scene->camera.position;
+    snapshot.cameraRotation = p_scene->camera.rotation;
+    snapshot.lightDirection = p_scene->light.direction;
+    snapshot.lightColorPrimary = p_scene->light.color_primary;
+    snapshot.lightColorAmbient = p_scene->light.color_ambient;
+
+    snapshots.publish();
+}
+
+void AssetCollection::resetComposeTimings()
+{
+    composeHistogram.reset();
+    for (auto &view : comparisonViews) {
+        view.composeHistogram.reset();
+    }
+}
+
+void AssetCollection::frameFinished(std::chrono::duration<double> frameDuration)
+{
+    if (cameraPathPlayer) {
+        cameraPathPlayer->advance(frameDuration);
+    }
+    if (cameraPathRecorder) {
+        cameraPathRecorder->record(p_scene->camera);
+    }
+    if (lodController.update(status)) {
+        setSharedParameter(StandardParam::LoDParams.name, lodController.getParams());
+    }
+    // the next render() resizes the render frame
+    if (resolutionController) {
+        resolutionController->update(status);
+    }
+}
+
+AssetCollection::OffscreenFrame AssetCollection::createOffscreenFrame(glm::uvec2 size,
+                                                                     const String &name)
+{
+    TextureManager &textureManager = root.getComponent<TextureManager>();
+
+    auto p_colorTexture = textureManager
+                              .register_asset(TextureSeed{Texture::EmptyParams{
+                                  .root = root,
+                                  .size = size,
+                                  .channelType = Texture::ChannelType::RGB,
+                                  .useMipMaps = false,
+                              }})
+                              .getLoaded();
+    auto p_depthTexture = textureManager
+                              .register_asset(TextureSeed{Texture::EmptyParams{
+                                  .root = root,
+                                  .size = size,
+                                  .channelType = Texture::ChannelType::DEPTH,
+                                  .useMipMaps = false,
+                              }})
+                              .getLoaded();
+
+    auto p_frame = root.getComponent<FrameStoreManager>()
+                       .register_asset(FrameStoreSeed{FrameStore::TextureBindParams{
+                           .root = root,
+                           .p_depthTexture = p_depthTexture,
+                           .p_colorTexture = p_colorTexture,
+                           .friendlyName = name,
+                       }})
+                       .getLoaded();
+
+    return OffscreenFrame{
+        .p_frame = p_frame,
+        .p_colorTexture = p_colorTexture,
+    };
 }
@@ -7,30 +7,175 @@
 #include "Vitrae/Pipelines/Compositing/Task.hpp"
 #include "Vitrae/Pipelines/Shading/Task.hpp"
 #include "Vitrae/Assets/Compositor.hpp"
+#include "Vitrae/Assets/FrameStore.hpp"
+#include "Vitrae/Assets/Texture.hpp"
 
+#include "CameraPath.hpp"
+#include "ComparisonView.hpp"
+#include "FrameBlitter.hpp"
+#include "FramePacer.hpp"
+#include "FrustumCuller.hpp"
+#include "GpuProfiler.hpp"
+#include "InputLatencyTracker.hpp"
+#include "LoDController.hpp"
+#include "MemoryBudget.hpp"
+#include "OcclusionCuller.hpp"
+#include "Options.hpp"
+#include "PipelineBuilder.hpp"
+#include "PipelineCache.hpp"
+#include "PrimitiveCounter.hpp"
+#include "ResolutionController.hpp"
+#include "SceneLoader.hpp"
+#include "Snapshot.hpp"
+#include "SpscQueue.hpp"
+#include "Status.hpp"
+
+#include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <vector>
 
 using namespace Vitrae;
 
 struct AssetCollection
 {
-    std::mutex accessMutex;
+    // Changes made by the GUI thread, applied by the render thread at the start of each frame
+    using Command = std::function<void(AssetCollection &)>;
+    static constexpr std::size_t COMMAND_QUEUE_CAPACITY = 1024;
 
-    bool running;
+    std::atomic<bool> running;
     bool shouldReloadPipelines;
-    std::size_t compositorInputsHash;
 
     ComponentRoot &root;
     Renderer &rend;
+    Status &status;
 
-    dynasma::FirmPtr<FrameStore> p_windowFrame;
+    // the window, or an offscreen frame when running headless
+    dynasma::FirmPtr<FrameStore> p_displayFrame;
+    // color output of the offscreen display frame, for reading it back (headless only)
+    dynasma::FirmPtr<Texture> p_displayColorTexture;
+    // what the compositor renders into; a scaled offscreen frame with dynamic resolution
+    dynasma::FirmPtr<FrameStore> p_renderFrame;
+    dynasma::FirmPtr<Texture> p_renderColorTexture;
+    // null until loadScene() finishes
     dynasma::FirmPtr<Scene> p_scene;
-    Compositor comp;
+    SceneLoader sceneLoader;
+    // holds all props of the scene while culling, leaving only the visible ones in the scene
+    std::optional<FrustumCuller> frustumCuller;
+    // removes the hidden props from the ones left by the frustum culler
+    std::optional<OcclusionCuller> occlusionCuller;
+    // the compositor in use; replaced when a newly built pipeline is ready
+    std::unique_ptr<Compositor> p_comp;
+    // the configuration to build the next pipeline with
+    PipelineConfig pipelineConfig;
+    // held by render() and by the short setup of each pipeline build, not by the rebuild
+    std::mutex engineMutex;
+    PipelineBuilder pipelineBuilder;
+    // previously used pipelines, for switching back without a rebuild
+    PipelineCache pipelineCache;
+    // rendered after the main pipeline, side by side in the window or into their own frames;
+    // created once, so their names stay in place for the GPU profiler
+    std::vector<ComparisonView> comparisonViews;
+    // CPU time of each compose of the main pipeline, for comparing it with the views
+    FrameTimeHistogram composeHistogram;
+
+    MemoryBudget memoryBudget;
+
+    LoDController lodController;
+    PrimitiveCounter primitiveCounter;
+    GpuProfiler gpuProfiler;
+    // used by the render loop, between the frames
+    FramePacer framePacer;
+    InputLatencyTracker inputLatencyTracker;
+
+    // scales the render frame, which is then upscaled to the display frame
+    std::optional<ResolutionController> resolutionController;
+    FrameBlitter frameBlitter;
+
+    std::optional<CameraPathPlayer> cameraPathPlayer;
+    std::optional<CameraPathRecorder> cameraPathRecorder;
+
+    SpscQueue<Command, COMMAND_QUEUE_CAPACITY> commands;
+    std::size_t queuedCommandCount;
+    std::atomic<std::size_t> appliedCommandCount;
 
-    AssetCollection(ComponentRoot &root, Renderer &rend, std::filesystem::path scenePath,
-                    float sceneScale);
+    // State for the GUI, published by the render thread
+    SnapshotBuffer<FrameSnapshot> snapshots;
+    std::size_t publishedFrameCount;
+
+    AssetCollection(ComponentRoot &root, Renderer &rend, Status &status, const Options &options);
     ~AssetCollection();
 
+    // loads the scene file and the camera path given in the options;
+    // to be called on the render thread before render()
+    void loadScene();
     void render();
+    // applies the pending commands, then blocks until the requested pipeline is swapped in
+    void waitForPipeline();
+    // rebuilds the pipeline in use, without storing the current one in the cache
+    void invalidatePipeline();
+    // to be called from the single producer (GUI) thread only
+    void queueCommand(Command command);
+    void applyCommands();
+    // whether the render thread has yet to apply some of the queued commands
+    bool hasPendingCommands() const;
+    void publishSnapshot(const Status &status);
+    // to be called after each measured render() with its duration
+    void frameFinished(std::chrono::duration<double> frameDuration);
+    // of the main pipeline and the comparison views
+    void resetComposeTimings();
+    // also switches the vsync of the compositor
+    void setFramePacing(FramePacer::Mode mode, double targetRate);
+
+    // sets the parameter of the main pipeline and of the comparison views,
+    // which only differ in their fs_display
+    template <class T> void setSharedParameter(const String &name, const T &value)
+    {
+        p_comp->parameters.set(name, value);
+        for (auto &view : comparisonViews) {
+            if (view.p_comp) {
+                view.p_comp->parameters.set(name, value);
+            }
+        }
+    }
+    // stamps the drag for the latency measurement and queues it; single producer thread only
+    void queueDrag(glm::vec2 motion, bool bLeft, bool bRight, bool bMiddle);
+    void dragCamera(glm::vec2 motion, bool bLeft, bool bRight, bool bMiddle);
+    // including the culled ones
+    std::size_t propCount() const;
+
+    struct OffscreenFrame
+    {
+        dynasma::FirmPtr<FrameStore> p_frame;
+        dynasma::FirmPtr<Texture> p_colorTexture;
+    };
+    OffscreenFrame createOffscreenFrame(glm::uvec2 size, const String &name);
+
+  private:
+    const Options &m_options;
+    bool m_hasPipeline;
+    bool m_shouldCleanMemoryPools;
+    // what the pipeline in use was built from
+    PipelineConfig m_activeConfig;
+    std::chrono::duration<double> m_activeBuildDuration;
+    bool m_activeCacheable;
+    // published for the settings window
+    std::shared_ptr<const InputSettings> mp_inputSettings;
+
+    // recreates the render frame if the scale or the display size changed
+    void updateRenderFrame();
+    void presentRenderFrame();
+    // the main pipeline and the comparison views side by side, if they're shown in the window
+    std::size_t viewportCount() const;
+    bool rendersOffscreen() const;
+    void composeComparisonViews();
+    void swapComparisonPipeline(ComparisonView &view, PipelineBuilder::Result pipeline);
+    void requestPipeline();
+    void swapPipeline(PipelineBuilder::Result pipeline, bool fromCache);
+    // if the input specs of the main pipeline changed
+    void updateInputSettings();
 };
\ No newline at end of file
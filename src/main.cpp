@@ -1,10 +1,22 @@
+#include <QtCore/QTimer>
 #include <QtWidgets/QApplication>
+#include <QtWidgets/QShortcut>
+#include <algorithm>
 #include <iostream>
+#include <optional>
 #include <thread>
 
+#include "Benchmark.hpp"
+#include "Explorer.hpp"
+#include "InputInjector.hpp"
+#include "Options.hpp"
 #include "ProfilerWindow.h"
 #include "SettingsWindow.h"
+#include "ShaderCache.hpp"
+#include "StartupTimes.hpp"
 #include "Status.hpp"
+#include "Sweep.hpp"
+#include "Trace.hpp"
 #include "assetCollection.hpp"
 
 #include "Vitrae/Renderer.hpp"
@@ -19,18 +31,34 @@
 
 using namespace Vitrae;
 
+static constexpr std::chrono::milliseconds WINDOW_EVENT_INTERVAL(4);
+
 int main(int argc, char **argv)
 {
-    String path = argv[1];
-    float sceneScale = 1.0f;
-    if (argc > 2) {
-        sceneScale = std::stof(argv[2]);
+    Options options;
+    try {
+        options = Options(argc, argv);
+    }
+    catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl << Options::usage(argv[0]);
+        return 1;
     }
 
     /*
     Setup the system
     */
 
+    StartupTimes startupTimes;
+    TraceRecorder::instance().setThreadName("Main");
+
+    // the driver reads its cache settings when the context is created
+    if (options.shaderCache) {
+        enableDriverShaderCache(options.shaderCachePath.empty() ? defaultShaderCacheDirectory()
+                                                                : options.shaderCachePath);
+    } else {
+        disableDriverShaderCache();
+    }
+
     ComponentRoot root;
 
     /*
@@ -42,19 +70,79 @@ int main(int argc, char **argv)
     VitraePluginFormGeneration::setup(root);
     VitraePluginPhongShading::setup(root);
     VitraePluginShadowFiltering::setup(root);
+    startupTimes.mark("Plugin setup");
 
     /*
     Render and GUI loops!
     */
     Renderer *p_rend = &root.getComponent<Renderer>();
-    {
+    int exitCode = 0;
+    if (options.headless) {
         p_rend->mainThreadSetup(root);
+        startupTimes.mark("Renderer setup");
+        {
+            Status status;
+            AssetCollection collection(root, *p_rend, status, options);
+            startupTimes.mark("Asset setup");
+            try {
+                collection.loadScene();
+            }
+            catch (const std::exception &e) {
+                std::cerr << e.what() << std::endl;
+                exitCode = 1;
+            }
+
+            if (exitCode == 0) {
+                startupTimes.mark("Scene loading");
+
+                collection.waitForPipeline();
+                startupTimes.mark("Pipeline build");
+                collection.render();
+                startupTimes.mark("First frame");
+                std::cerr << startupTimes;
+                status.startupTimes = startupTimes;
+
+                std::optional<InputInjector> inputInjector;
+                if (options.inputInjectionRate > 0.0) {
+                    inputInjector.emplace(collection, options.inputInjectionRate);
+                }
+
+                if (options.sweep) {
+                    exitCode = runSweep(collection, status, options);
+                } else if (!options.exploreRanges.empty()) {
+                    exitCode = runExplorer(collection, status, options);
+                } else {
+                    exitCode = runBenchmark(collection, status, options);
+                }
+
+                inputInjector.reset();
+
+                if (collection.cameraPathRecorder) {
+                    try {
+                        collection.cameraPathRecorder->getPath().save(
+                            options.recordCameraPathPath);
+                    }
+                    catch (const std::exception &e) {
+                        std::cerr << e.what() << std::endl;
+                        exitCode = 1;
+                    }
+                }
+            }
+        }
+        if (!options.tracePath.empty()) {
+            writeTraceFile(options.tracePath, options.traceDuration);
+        }
+        p_rend->mainThreadFree();
+    } else {
+        p_rend->mainThreadSetup(root);
+        startupTimes.mark("Renderer setup");
 
         /*
         Assets
         */
-        AssetCollection collection(root, *p_rend, path, sceneScale);
         Status status;
+        AssetCollection collection(root, *p_rend, status, options);
+        startupTimes.mark("Asset setup");
 
         /*
         GUI setup
@@ -64,6 +152,7 @@ int main(int argc, char **argv)
         settingsWindow.show();
         ProfilerWindow profilerWindow(collection, status);
         profilerWindow.show();
+        startupTimes.mark("GUI setup");
 
         /*
         Render loop!
@@ -71,43 +160,127 @@ int main(int argc, char **argv)
         p_rend->anyThreadDisable();
         std::thread renderThread([&]() {
             p_rend->anyThreadEnable();
+            TraceRecorder::instance().setThreadName("Render");
+
+            // the GUI is already up and shows the loading progress meanwhile
+            try {
+                collection.loadScene();
+            }
+            catch (const std::exception &e) {
+                std::cerr << e.what() << std::endl;
+                collection.running = false;
+                // read after the thread is joined
+                exitCode = 1;
+            }
+            startupTimes.mark("Scene loading");
+
+            if (collection.running) {
+                collection.waitForPipeline();
+                startupTimes.mark("Pipeline build");
+                collection.render();
+                startupTimes.mark("First frame");
+                std::cerr << startupTimes;
+                status.startupTimes = startupTimes;
+            }
+
             while (collection.running) {
+                collection.framePacer.beginFrame();
+
+                // the GUI only queues commands and reads the published snapshots, so no lock
+                auto startTime = std::chrono::high_resolution_clock::now();
                 {
-                    std::unique_lock lock1(collection.accessMutex);
+                    PROFILE_SCOPE("Render iteration");
 
-                    auto startTime = std::chrono::high_resolution_clock::now();
-                    {
-                        MMETER_SCOPE_PROFILER("Render iteration");
+                    collection.render();
+                }
+                auto endTime = std::chrono::high_resolution_clock::now();
 
-                        collection.render();
-                    }
-                    auto endTime = std::chrono::high_resolution_clock::now();
+                status.update(endTime - startTime);
+                collection.frameFinished(endTime - startTime);
+                collection.publishSnapshot(status);
 
-                    status.update(endTime - startTime);
-                }
-                std::this_thread::sleep_for(std::chrono::microseconds(1));
+                collection.framePacer.wait();
             }
             p_rend->anyThreadDisable();
         });
 
         /*
         GUI loop!
+        Window events are polled often for responsive input,
+        while the GUI is refreshed from the published snapshots at a limited rate
         */
+        QTimer windowEventTimer;
+        QObject::connect(&windowEventTimer, &QTimer::timeout,
+                         [&]() { p_rend->mainThreadUpdate(); });
+        windowEventTimer.start(WINDOW_EVENT_INTERVAL);
+
+        QTimer refreshTimer;
+        QObject::connect(&refreshTimer, &QTimer::timeout, [&]() {
+            settingsWindow.updateSceneLoading(collection.sceneLoader.getProgress());
+            if (collection.snapshots.receive()) {
+                settingsWindow.updateValues(collection.snapshots.readBuffer());
+                profilerWindow.updateValues(collection.snapshots.readBuffer());
+            }
+        });
+        // a zero interval would make the GUI busy-loop, so rates above 1 kHz are capped
+        auto refreshInterval = std::chrono::milliseconds(
+            (std::chrono::milliseconds::rep)(1000.0 / options.guiRefreshRate));
+        refreshTimer.start(std::max(refreshInterval, std::chrono::milliseconds(1)));
+
+        QShortcut traceShortcut(QKeySequence(Qt::Key_F12), &settingsWindow);
+        traceShortcut.setContext(Qt::ApplicationShortcut);
+        QObject::connect(&traceShortcut, &QShortcut::activated, [&]() {
+            writeTraceFile(options.tracePath.empty() ? "trace.json" : options.tracePath,
+                           options.traceDuration);
+        });
+
         while (collection.running) {
-            app.processEvents();
-            p_rend->mainThreadUpdate();
-            settingsWindow.updateValues();
-            profilerWindow.updateValues();
+            app.processEvents(QEventLoop::WaitForMoreEvents);
         }
 
         renderThread.join();
         p_rend->anyThreadEnable();
 
+        if (collection.cameraPathRecorder) {
+            try {
+                collection.cameraPathRecorder->getPath().save(options.recordCameraPathPath);
+            }
+            catch (const std::exception &e) {
+                std::cerr << e.what() << std::endl;
+                exitCode = 1;
+            }
+        }
+        if (!options.reportPath.empty()) {
+            Report report{options, status};
+            if (collection.cameraPathPlayer) {
+                report.p_cameraPath = &*collection.cameraPathPlayer;
+            }
+            report.p_memoryBudget = &collection.memoryBudget;
+            if (collection.p_scene) {
+                report.propCount = collection.propCount();
+            }
+            if (collection.frustumCuller) {
+                report.p_frustumCuller = &*collection.frustumCuller;
+            }
+            if (collection.occlusionCuller) {
+                report.p_occlusionCuller = &*collection.occlusionCuller;
+            }
+            report.p_gpuTimes = &collection.gpuProfiler.getTotals();
+            report.p_framePacer = &collection.framePacer;
+            report.p_inputLatencyTracker = &collection.inputLatencyTracker;
+            report.p_comparisonViews = &collection.comparisonViews;
+            report.p_composeHistogram = &collection.composeHistogram;
+            writeReport(report, options);
+        }
+        if (!options.tracePath.empty()) {
+            writeTraceFile(options.tracePath, options.traceDuration);
+        }
+
         /*
         Free resources
         */
         p_rend->mainThreadFree();
     }
 
-    return 0;
+    return exitCode;
 }